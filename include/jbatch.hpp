@@ -0,0 +1,168 @@
+/**
+ * @file jbatch.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Many small documents packed into one buffer
+ *
+ * @details This header provides BatchBuilder for workloads that produce
+ * thousands of tiny documents, such as pub/sub fan-out. Instead of a new
+ * Builder (one malloc and free) per message, the documents are written back
+ * to back into one growing buffer, kept across batches, with an index of
+ * offset and length per document. The batch is then available as one
+ * contiguous block for a single write, or as one view per document.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * BatchBuilder batch(64 * 1024, '\n');   // NDJSON
+ * for (const auto& event : events)
+ * {
+ *     batch.Add([&](Builder& b) {
+ *         if (!event.valid()) { return false; }  // rolled back
+ *         wwjson::to_json(b, event);
+ *         return true;
+ *     });
+ * }
+ * ::write(fd, batch.data(), batch.bytes());
+ * batch.Clear();                         // keep the memory for the next batch
+ * ```
+ */
+
+#pragma once
+#ifndef JBATCH_HPP__
+#define JBATCH_HPP__
+
+#include "jbuilder.hpp"
+
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace wwjson {
+
+/// @brief Builder of many documents back to back in one buffer
+/// @details Each document is written between Begin() and Commit(), or
+/// dropped by Rollback(). Views of the documents and of the whole batch are
+/// valid until the buffer is written again.
+class BatchBuilder
+{
+public:
+    /// Offset and length of one document in the batch buffer.
+    struct Entry
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    /// @param capacity Initial buffer capacity for the whole batch
+    /// @param delimiter Byte written after each document, '\0' for none
+    explicit BatchBuilder(size_t capacity = 4096, char delimiter = '\0')
+        : m_builder(capacity), m_delimiter(delimiter)
+    {
+    }
+
+    /// @brief Start a new document
+    /// @return The builder to write the document with
+    Builder& Begin()
+    {
+        if (wwjson_unlikely(m_open)) { Rollback(); }
+        m_start = m_builder.json.size();
+        m_open = true;
+        return m_builder;
+    }
+
+    /// @brief Finish the current document and index it
+    /// @return Index of the document
+    size_t Commit()
+    {
+        JString& json = m_builder.json;
+        if (json.size() > m_start && json.back() == ',') { json.pop_back(); }
+        m_index.push_back(Entry{m_start, json.size() - m_start});
+        if (m_delimiter != '\0') { m_builder.PutChar(m_delimiter); }
+        m_open = false;
+        return m_index.size() - 1;
+    }
+
+    /// Drop the current document, as if Begin() was not called.
+    void Rollback()
+    {
+        m_builder.json.resize(m_start);
+        m_open = false;
+    }
+
+    /// @brief Write one document by a callable, rolled back if it fails
+    /// @param build `void(Builder&)` or `bool(Builder&)` returning false to
+    /// roll back
+    /// @return true if committed
+    template <typename Func>
+    bool Add(Func&& build)
+    {
+        Builder& builder = Begin();
+        if constexpr (std::is_same_v<std::invoke_result_t<Func, Builder&>, bool>)
+        {
+            if (!build(builder))
+            {
+                Rollback();
+                return false;
+            }
+        }
+        else
+        {
+            build(builder);
+        }
+        Commit();
+        return true;
+    }
+
+    /// Serialize a value as one document, like wwjson::to_json.
+    template <typename valueT>
+    size_t AddValue(const valueT& value)
+    {
+        wwjson::to_json(Begin(), value);
+        return Commit();
+    }
+
+    /// Number of committed documents.
+    size_t size() const { return m_index.size(); }
+    bool empty() const { return m_index.empty(); }
+
+    /// Document i, without the delimiter.
+    std::string_view operator[](size_t i) const
+    {
+        const Entry& entry = m_index[i];
+        return std::string_view(m_builder.json.data() + entry.offset, entry.length);
+    }
+
+    /// Index of all committed documents.
+    const std::vector<Entry>& index() const { return m_index; }
+
+    /// The whole batch as contiguous memory, delimiters included.
+    const char* data() const { return m_builder.json.data(); }
+    size_t bytes() const { return m_open ? m_start : m_builder.json.size(); }
+    std::string_view view() const { return std::string_view(data(), bytes()); }
+
+    /// Drop all documents, keeping the buffer memory for the next batch.
+    void Clear()
+    {
+        m_builder.json.clear();
+        m_index.clear();
+        m_start = 0;
+        m_open = false;
+    }
+
+    /// Current buffer capacity, for memory checks.
+    size_t capacity() const { return m_builder.json.capacity(); }
+
+private:
+    Builder m_builder;
+    std::vector<Entry> m_index;
+    size_t m_start = 0;
+    char m_delimiter;
+    bool m_open = false;
+};
+
+} // namespace wwjson
+
+#endif // JBATCH_HPP__
@@ -16,6 +16,7 @@
  * @par Type Aliases:
  * - **Builder**: GenericBuilder<JString> - Standard JSON building with safety margin
  * - **FastBuilder**: GenericBuilder<KString> - Maximum performance with single allocation
+ * - **SpillBuilder**: GenericBuilder<SpillString> - Caller buffer first, spill to heap when full
  * - **JObject**: GenericObject<JString> - RAII object wrapper for Builder
  * - **JArray**: GenericArray<JString> - RAII array wrapper for Builder
  * - **FastObject**: GenericObject<KString> - RAII object wrapper for FastBuilder
@@ -41,6 +42,15 @@
 
 namespace wwjson {
 
+namespace detail {
+
+/// Room UnsafeConfig::NumberString reserves before formatting a float. A
+/// KString allocated for a measured size needs it on top, or a float near
+/// the end would reallocate.
+constexpr size_t kNumberReserve = 64;
+
+} // namespace detail
+
 /// @brief Optimized config for high-unsafe-level string types
 /// @details
 /// Inherits from BasicConfig and provides optimized implementations for
@@ -145,7 +155,7 @@ struct UnsafeConfig : public BasicConfig<stringT>
             return;
         }
 
-        dst.reserve_ex(64);
+        dst.reserve_ex(detail::kNumberReserve);
 #if defined(WWJSON_USE_EXTERNAL_DTOA)
         external::NumberWriter<stringT>::Output(dst, value);
 #else
@@ -195,6 +205,72 @@ using Builder = GenericBuilder<JString, UnsafeConfig<JString>>;
 /// @endcode
 using FastBuilder = GenericBuilder<KString, UnsafeConfig<KString>>;
 
+/// @brief Builder using SpillString (SpillBuffer<4>) over caller memory
+/// @details
+/// Writes into a caller-provided buffer (e.g. stack array) and moves to heap
+/// only when the buffer is full, so the output is never truncated.
+///
+/// @par When to use SpillBuilder:
+/// - Hot paths where most documents fit in a stack/socket buffer
+/// - When the worst-case size is unknown or much larger than the common case
+///
+/// @par Example:
+/// @code
+/// char buf[512];
+/// SpillBuilder builder(SpillString(buf), 0);  // 0: no upfront reserve
+/// builder.BeginObject();
+/// builder.AddMember("key", "value");
+/// builder.EndObject();
+/// bool onHeap = builder.json.spilled();
+/// std::string_view json = builder.GetResult();
+/// @endcode
+using SpillBuilder = GenericBuilder<SpillString, UnsafeConfig<SpillString>>;
+
+namespace detail {
+
+/// String types holding the whole output in memory and growing on demand.
+template <typename stringT>
+struct is_growing_string : std::false_type {};
+
+template <>
+struct is_growing_string<std::string> : std::true_type {};
+
+template <UnsafeLevel LEVEL>
+struct is_growing_string<StringBuffer<LEVEL>> : std::bool_constant<(LEVEL < 0xFF)> {};
+
+/// UnsafeConfig over JString with the flags of configT.
+template <typename configT>
+struct GrowingConfig : public UnsafeConfig<JString>
+{
+    static constexpr bool kEscapeKey = configT::kEscapeKey;
+    static constexpr bool kEscapeValue = configT::kEscapeValue;
+    static constexpr bool kQuoteNumber = configT::kQuoteNumber;
+    static constexpr bool kTailComma = configT::kTailComma;
+    static constexpr bool kValidateSub = configT::kValidateSub;
+};
+
+template <typename configT>
+inline constexpr bool has_builder_flags_v =
+    configT::kEscapeKey == UnsafeConfig<JString>::kEscapeKey &&
+    configT::kEscapeValue == UnsafeConfig<JString>::kEscapeValue &&
+    configT::kQuoteNumber == UnsafeConfig<JString>::kQuoteNumber &&
+    configT::kTailComma == UnsafeConfig<JString>::kTailComma &&
+    configT::kValidateSub == UnsafeConfig<JString>::kValidateSub;
+
+/// @brief Default constructible builder writing the same text as builderT
+/// @details For parts built apart and then copied into a builderT. It is
+/// builderT itself over a growing string. Otherwise (KString that cannot
+/// grow, FlushString, BufferView or SlotView that hold only a window) it is
+/// a JString builder with the same config flags, plain Builder for the
+/// default ones. Only the flags are carried over, as in CountingConfig.
+template <typename builderT, typename configT = typename builderT::config_type>
+using growing_builder_t = std::conditional_t<
+    is_growing_string<typename builderT::string_type>::value, builderT,
+    std::conditional_t<has_builder_flags_v<configT>, Builder,
+                       GenericBuilder<JString, GrowingConfig<configT>>>>;
+
+} // namespace detail
+
 // ============================================================================
 // to_json Helper Functions - Simplified struct-to-JSON serialization
 // ============================================================================
@@ -257,6 +333,25 @@ template <typename T>
 inline constexpr bool is_scalar_v =
     is_key_v<T> || std::is_arithmetic_v<std::decay_t<T>>;
 
+/// @brief Type trait to detect a struct described by WWJSON_FIELDS
+/// @details The macro defines `wwjson_fields(const T*)` next to the type,
+/// found here by argument-dependent lookup.
+template <typename T, typename = void>
+struct has_fields : std::false_type {};
+
+template <typename T>
+struct has_fields<T, std::void_t<
+    decltype(wwjson_fields(static_cast<const T*>(nullptr)))
+>> : std::true_type {};
+
+/// @brief Compile-time check for types described by WWJSON_FIELDS
+template <typename T>
+inline constexpr bool has_fields_v = has_fields<T>::value;
+
+/// @brief Serialize a WWJSON_FIELDS struct, defined in jfields.hpp
+template <typename builderT, typename structT>
+void write_fields(builderT& builder, const structT& value);
+
 /// @brief Unified to_json_impl function with compile-time key detection
 /// @tparam builderT GenericBuilder type
 /// @tparam keyT Key type (is_key for member, NotKey for array element)
@@ -316,6 +411,13 @@ void to_json_impl(builderT& builder, keyT&& key, valueT&& value)
         }
         builder.EndArray();
     }
+    else if constexpr (has_fields_v<decayT>) {
+        // Struct described by WWJSON_FIELDS: pre-rendered key fragments
+        if constexpr (has_key) {
+            builder.AddMember(std::forward<keyT>(key));
+        }
+        write_fields(builder, value);
+    }
     else {
         // Struct: assume has to_json(builder) method
         if constexpr (has_key) {
@@ -327,6 +429,35 @@ void to_json_impl(builderT& builder, keyT&& key, valueT&& value)
     }
 }
 
+/// @brief Extract the result of a Builder (or FastBuilder) as resultT
+/// @details JString and ReleasedBuffer take over the memory without copy,
+/// std::string copies once.
+template <typename resultT, typename builderT = Builder>
+resultT move_result(builderT& builder)
+{
+    if constexpr (std::is_same_v<resultT, JString>)
+    {
+        if constexpr (std::is_same_v<typename builderT::string_type, JString>)
+        {
+            return builder.MoveResult();
+        }
+        else
+        {
+            return JString(builder.MoveResult().release());
+        }
+    }
+    else if constexpr (std::is_same_v<resultT, ReleasedBuffer>)
+    {
+        return builder.MoveResult().release();
+    }
+    else
+    {
+        static_assert(std::is_same_v<resultT, std::string>,
+            "to_json result type must be std::string, JString or ReleasedBuffer");
+        return builder.MoveResult().str();
+    }
+}
+
 } // namespace detail
 
 /// @brief Serialize a value with a key
@@ -352,6 +483,33 @@ void to_json(builderT& builder, valueT&& value)
     detail::to_json_impl(builder, detail::NotKey{}, std::forward<valueT>(value));
 }
 
+/// @brief Serialize a struct to JSON using default Builder, as resultT
+/// @tparam resultT Result type: std::string (one copy), or JString /
+/// ReleasedBuffer which take over the builder's memory without copy
+/// @tparam structT Type with to_json(builder) method
+/// @param st Struct instance to serialize
+/// @par Example:
+/// @code
+/// JString js = wwjson::to_json_as<JString>(st);          // zero copy
+/// auto rb = wwjson::to_json_as<ReleasedBuffer>(st);       // rb.ptr, rb.size
+/// @endcode
+template <typename resultT, typename structT>
+resultT to_json_as(const structT& st)
+{
+    Builder builder;
+    if constexpr (detail::has_fields_v<structT>)
+    {
+        detail::write_fields(builder, st);
+    }
+    else
+    {
+        builder.BeginObject();
+        st.to_json(builder);
+        builder.EndObject();
+    }
+    return detail::move_result<resultT>(builder);
+}
+
 /// @brief Serialize a struct to JSON string using default Builder
 /// @tparam structT Type with to_json(builder) method
 /// @param st Struct instance to serialize
@@ -359,11 +517,7 @@ void to_json(builderT& builder, valueT&& value)
 template <typename structT>
 std::string to_json(const structT& st)
 {
-    Builder builder;
-    builder.BeginObject();
-    st.to_json(builder);
-    builder.EndObject();
-    return builder.MoveResult().str();
+    return to_json_as<std::string>(st);
 }
 
 // ============================================================================
@@ -0,0 +1,355 @@
+/**
+ * @file jcache.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Caches of rendered JSON for repeated responses
+ *
+ * @details This header provides RenderCache for documents that are built
+ * again and again with the same structure and only a few changing values.
+ * The first build is recorded with the normal Builder API, marking the
+ * changing values with RenderCache::Slot(). The output is then split into
+ * literal segments around the value slots, and later renders only copy the
+ * segments and write the new values, like a JsonTemplate built at run time.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * static thread_local RenderCache cache;
+ * if (!cache.valid(kSchemaVersion))
+ * {
+ *     cache.Record([&](Builder& b) {
+ *         b.BeginObject();
+ *         b.AddMember("code", RenderCache::Slot());
+ *         AddStaticConfig(b);        // constant part, recorded as literal
+ *         b.AddMember("user", RenderCache::Slot());
+ *         b.EndObject();
+ *     }, kSchemaVersion);
+ * }
+ * std::string json = cache.Render(code, user_name);
+ * ```
+ *
+ * It also provides MemoCache, which memoizes the serialized fragments of
+ * shared objects (the same `shared_ptr<User>` appearing many times across
+ * documents). A fragment is keyed on the object identity plus a user
+ * version, and spliced as a raw sub-JSON on a hit. The cache is sharded by
+ * object address, each shard with its own lock and LRU order, within a
+ * total memory budget.
+ */
+
+#pragma once
+#ifndef JCACHE_HPP__
+#define JCACHE_HPP__
+
+#include "jbuilder.hpp"
+#include "jtemplate.hpp"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wwjson {
+
+/// @brief Recorded document of literal segments and value slots
+/// @details
+/// A slot takes one complete JSON value at render time, written by its type
+/// as in JsonTemplate: numbers and bools as is, strings quoted (escaped if
+/// the builder config says so), nullptr and empty optionals as null.
+///
+/// The structure is identified by a user version number given to Record().
+/// When the structure changes, check valid() with the new version or call
+/// Invalidate(), and record again.
+///
+/// @note Constant string values in the recording must not contain the byte
+/// 0x01, which marks the slots.
+class RenderCache
+{
+public:
+    /// Placeholder value marking a slot while recording.
+    static constexpr std::string_view Slot() { return std::string_view("\x01", 1); }
+
+    /// @brief Record the document structure from a build on a Builder
+    /// @param build Callable `void(Builder&)`, marking values with Slot()
+    /// @param version User version of the structure, checked by valid()
+    /// @return Number of slots found
+    template <typename buildT>
+    size_t Record(buildT&& build, uint64_t version = 0)
+    {
+        Builder builder;
+        build(builder);
+        const JString& json = builder.GetResult();
+        std::string_view text(json.data(), json.size());
+
+        m_text.clear();
+        m_offset.clear();
+        m_text.reserve(text.size());
+        m_offset.push_back(0);
+        size_t start = 0;
+        for (size_t pos = text.find('\x01'); pos != std::string_view::npos;
+             pos = text.find('\x01', pos + 2))
+        {
+            // a slot is the quoted placeholder "\x01"
+            if (pos == 0 || text[pos - 1] != '"' || pos + 1 >= text.size() || text[pos + 1] != '"')
+            {
+                continue;
+            }
+            m_text.append(text.data() + start, pos - 1 - start);
+            m_offset.push_back(static_cast<uint32_t>(m_text.size()));
+            start = pos + 2;
+        }
+        m_text.append(text.data() + start, text.size() - start);
+        m_offset.push_back(static_cast<uint32_t>(m_text.size()));
+
+        m_version = version;
+        m_recorded = true;
+        return slots();
+    }
+
+    /// Forget the recorded structure.
+    void Invalidate()
+    {
+        m_text.clear();
+        m_offset.clear();
+        m_recorded = false;
+    }
+
+    /// True if recorded, with the same structure version.
+    bool valid(uint64_t version = 0) const { return m_recorded && m_version == version; }
+    explicit operator bool() const { return m_recorded; }
+
+    /// Number of value slots of the recorded document.
+    size_t slots() const { return m_offset.size() < 2 ? 0 : m_offset.size() - 2; }
+
+    /// Total bytes of literal segments.
+    size_t literal_size() const { return m_text.size(); }
+
+    /// @brief Append the document with new slot values to a builder
+    /// @return false and write nothing if not recorded or the argument
+    /// count differs from the slots
+    template <typename builderT, typename... argsT>
+    bool Write(builderT& builder, const argsT&... args) const
+    {
+        if (wwjson_unlikely(!m_recorded || sizeof...(argsT) != slots())) { return false; }
+        builder.Reserve(m_text.size() + (detail::template_value_size(args) + ... + 0));
+        size_t i = 0;
+        auto put = [&](const auto& arg) {
+            PutSegment(builder, i++);
+            detail::put_template_value(builder, arg);
+        };
+        (put(args), ...);
+        PutSegment(builder, i);
+        return true;
+    }
+
+    /// @brief Render the document with new slot values
+    /// @tparam resultT std::string (default), JString or ReleasedBuffer
+    /// @return Empty result if Write() fails
+    template <typename resultT = std::string, typename... argsT>
+    resultT Render(const argsT&... args) const
+    {
+        Builder builder(m_text.size() + 16 * sizeof...(argsT));
+        Write(builder, args...);
+        return detail::move_result<resultT>(builder);
+    }
+
+private:
+    template <typename builderT>
+    void PutSegment(builderT& builder, size_t i) const
+    {
+        size_t len = m_offset[i + 1] - m_offset[i];
+        if (len > 0) { builder.Append(m_text.data() + m_offset[i], len); }
+    }
+
+    std::string m_text;              ///< Literal segments back to back
+    std::vector<uint32_t> m_offset;  ///< Start of each segment, then the end
+    uint64_t m_version = 0;
+    bool m_recorded = false;
+};
+
+/// @brief Memo of serialized fragments of shared objects
+/// @details
+/// An entry is keyed on the object address and checked against the owner
+/// (a freed object whose address is reused does not hit) and the version
+/// given by the caller, which should change whenever the object changes.
+/// Least recently used entries are evicted per shard when over budget, and
+/// fragments larger than a shard's budget are not stored.
+///
+/// Fragments are rendered with the flags of the builder config (escaping,
+/// number quoting) on a miss, but are not keyed on them: builders sharing
+/// one cache should share one config.
+///
+/// All methods are thread safe.
+///
+/// @par Usage Example:
+/// ```cpp
+/// MemoCache memo(8 << 20);  // 8 MB
+/// void Post::to_json(Builder& builder) const
+/// {
+///     TO_JSON(id);
+///     memo.to_json(builder, "author", author, author->version);
+/// }
+/// ```
+class MemoCache
+{
+public:
+    /// @param budget Total bytes of stored fragments
+    /// @param shards Number of independently locked shards
+    explicit MemoCache(size_t budget = 4 * 1024 * 1024, size_t shards = 16)
+        : m_shards(shards > 0 ? shards : 1)
+    {
+        m_shard_budget = budget / m_shards.size();
+    }
+
+    MemoCache(const MemoCache&) = delete;
+    MemoCache& operator=(const MemoCache&) = delete;
+
+    /// @brief Serialize `*object` as member `key`, from the memo when possible
+    /// @details A null pointer is written as null.
+    template <typename builderT, typename keyT, typename valueT>
+    void to_json(builderT& builder, keyT&& key, const std::shared_ptr<valueT>& object,
+                 uint64_t version = 0)
+    {
+        builder.PutKey(std::forward<keyT>(key));
+        Write(builder, object, version);
+        builder.SepItem();
+    }
+
+    /// @brief Serialize `*object` as an array element, from the memo when possible
+    template <typename builderT, typename valueT>
+    void to_json(builderT& builder, const std::shared_ptr<valueT>& object, uint64_t version = 0)
+    {
+        Write(builder, object, version);
+        builder.SepItem();
+    }
+
+    /// Drop all entries.
+    void Clear()
+    {
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.lru.clear();
+            shard.index.clear();
+            shard.bytes = 0;
+        }
+    }
+
+    size_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+    size_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+    /// Total bytes of stored fragments.
+    size_t bytes() const
+    {
+        size_t total = 0;
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.bytes;
+        }
+        return total;
+    }
+
+private:
+    struct Entry
+    {
+        const void* address = nullptr;
+        std::weak_ptr<const void> owner;
+        uint64_t version = 0;
+        std::string fragment;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;  ///< Most recently used first
+        std::unordered_map<const void*, std::list<Entry>::iterator> index;
+        size_t bytes = 0;
+    };
+
+    Shard& ShardOf(const void* address)
+    {
+        uint64_t mix = (reinterpret_cast<uintptr_t>(address) >> 4) * 0x9E3779B97F4A7C15ULL;
+        return m_shards[(mix >> 32) % m_shards.size()];
+    }
+
+    static bool SameOwner(const std::weak_ptr<const void>& a, const std::shared_ptr<const void>& b)
+    {
+        return !a.owner_before(b) && !b.owner_before(a);
+    }
+
+    /// Write the fragment without separator.
+    template <typename builderT, typename valueT>
+    void Write(builderT& builder, const std::shared_ptr<valueT>& object, uint64_t version)
+    {
+        if (!object)
+        {
+            builder.PutNull();
+            return;
+        }
+        std::shared_ptr<const void> owner(object, static_cast<const void*>(object.get()));
+        const void* address = owner.get();
+        Shard& shard = ShardOf(address);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.index.find(address);
+            if (it != shard.index.end())
+            {
+                Entry& entry = *it->second;
+                if (entry.version == version && SameOwner(entry.owner, owner))
+                {
+                    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                    builder.PutSub(entry.fragment.data(), entry.fragment.size());
+                    m_hits.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+
+        // serialize outside the lock
+        detail::growing_builder_t<builderT> sub;
+        wwjson::to_json(sub, *object);
+        const auto& json = sub.GetResult();
+        builder.PutSub(json.data(), json.size());
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        Store(shard, address, owner, version, std::string(json.data(), json.size()));
+    }
+
+    void Store(Shard& shard, const void* address, const std::shared_ptr<const void>& owner,
+               uint64_t version, std::string&& fragment)
+    {
+        if (fragment.size() > m_shard_budget) { return; }
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(address);
+        if (it != shard.index.end())
+        {
+            shard.bytes -= it->second->fragment.size();
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+        shard.bytes += fragment.size();
+        shard.lru.push_front(Entry{address, owner, version, std::move(fragment)});
+        shard.index[address] = shard.lru.begin();
+
+        while (shard.bytes > m_shard_budget && !shard.lru.empty())
+        {
+            Entry& last = shard.lru.back();
+            shard.bytes -= last.fragment.size();
+            shard.index.erase(last.address);
+            shard.lru.pop_back();
+        }
+    }
+
+    std::vector<Shard> m_shards;
+    size_t m_shard_budget = 0;
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+};
+
+} // namespace wwjson
+
+#endif // JCACHE_HPP__
@@ -0,0 +1,440 @@
+/**
+ * @file jconcurrent.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Lock-free shared output buffer for many JSON producer threads
+ *
+ * @details This header provides ConcurrentBuffer, where producer threads
+ * reserve a byte range with one atomic fetch-add, build a document directly
+ * into that range with SlotBuilder (a GenericBuilder over SlotView), and
+ * commit it. A single consumer thread flushes completed blocks to a
+ * FlushSink. No mutex is taken and the document is never copied on the
+ * producer side.
+ *
+ * @par Type Aliases:
+ * - **SlotBuilder**: GenericBuilder<SlotView> - bounded builder over a reserved slot
+ */
+
+#pragma once
+#ifndef JCONCURRENT_HPP__
+#define JCONCURRENT_HPP__
+
+#include "jsink.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace wwjson {
+
+/// @brief BufferView over a reserved slot that remembers dropped writes
+/// @details BufferView skips a whole write that does not fit, which would
+/// leave a corrupt document; SlotView records it so that Slot::commit()
+/// can drop the document instead.
+class SlotView : public BufferView
+{
+public:
+    using BufferView::BufferView;
+
+    void push_back(char c)
+    {
+        if (wwjson_unlikely(m_end + 1 > m_cap_end)) { m_truncated = true; return; }
+        unsafe_push_back(c);
+    }
+
+    void append(size_t count, char ch)
+    {
+        if (wwjson_unlikely(m_end + count > m_cap_end)) { m_truncated = true; return; }
+        unsafe_fill(ch, count);
+    }
+
+    void append(const char* str, size_t len)
+    {
+        if (wwjson_unlikely(m_end + len > m_cap_end)) { m_truncated = true; return; }
+        unsafe_append(str, len);
+    }
+
+    void append(const char* str)
+    {
+        if (str == nullptr) { return; }
+        append(str, ::strlen(str));
+    }
+
+    void append(const std::string& str) { append(str.data(), str.size()); }
+    void append(const std::string_view& sv) { append(sv.data(), sv.size()); }
+    void append(const BufferView& other) { append(other.data(), other.size()); }
+
+    /// True if any write has been dropped for lack of space.
+    bool truncated() const { return m_truncated; }
+
+private:
+    bool m_truncated = false;
+};
+
+/// @brief Builder writing into the reserved slice of a ConcurrentBuffer
+using SlotBuilder = GenericBuilder<SlotView>;
+
+/// @brief Shared output buffer with lock-free reservation and ordered flush
+/// @details
+/// The memory is a ring of fixed-size blocks. Producers append into the
+/// current block; the consumer writes out a block once it is sealed and every
+/// reservation in it has been committed, then recycles it.
+///
+/// @par Reservation:
+/// Each block keeps one 64-bit word packing the reserved byte count (low 40
+/// bits) and record count (high 24 bits), so reserve() is a single
+/// fetch-add. Record descriptors `{offset, length}` grow down from the end of
+/// the block. The one reservation that crosses the block end seals the block
+/// and moves producers on to the next one; the others just retry there.
+/// Every record takes at least its descriptor, so blocks are limited to
+/// `2^24 * kEntrySize` bytes (128 MiB) for the count not to overflow.
+///
+/// @par Commit/Publish Protocol:
+/// - reserve(max_len) returns a Slot of `max_len` writable bytes, or an
+///   empty Slot when all blocks are waiting to be flushed (caller decides to
+///   retry, yield or drop)
+/// - Slot::commit(len) publishes the first `len` bytes; when no one has
+///   reserved after the slot, the unused tail is given back with one CAS, so
+///   that consecutive records stay contiguous
+/// - A Slot destroyed without commit publishes an empty record
+/// - flush() (consumer thread only) writes each completed block with one
+///   sink call per contiguous run of records, in reservation order
+/// - flush(true) also seals a partially filled block, for low-rate streams
+///   and at shutdown; finish() is the same and is called by the destructor
+///
+/// @par Usage Example:
+/// ```cpp
+/// ConcurrentBuffer shared(FdSink(fd));
+/// // producer threads
+/// auto slot = shared.reserve(512);
+/// if (slot) {
+///     SlotBuilder builder(slot.view(), 0);
+///     builder.BeginObject();
+///     builder.AddMember("id", id);
+///     builder.EndObject();
+///     builder.GetResult();
+///     builder.PutChar('\n');
+///     slot.commit(builder);
+/// }
+/// // consumer thread
+/// shared.flush();
+/// ```
+///
+/// @note A document that does not fit its slot is committed empty by
+/// Slot::commit(SlotBuilder&), which returns false then.
+class ConcurrentBuffer
+{
+    static constexpr int kCountShift = 40;
+    static constexpr uint64_t kCountOne = uint64_t(1) << kCountShift;
+    static constexpr uint64_t kBytesMask = kCountOne - 1;
+    static constexpr uint64_t kOpen = ~uint64_t(0);
+    static constexpr size_t kEntrySize = 2 * sizeof(uint32_t);
+    /// Largest block whose record count fits the 24 bits of a packed word.
+    static constexpr size_t kMaxBlockSize = (size_t(1) << (64 - kCountShift)) * kEntrySize;
+
+    struct Block
+    {
+        std::atomic<uint64_t> reserved{0};   ///< Packed reservations (fetch-add)
+        std::atomic<uint64_t> committed{0};  ///< Packed commits, same layout
+        std::atomic<uint64_t> sealed{kOpen}; ///< Packed final reservations
+        std::atomic<uint64_t> seq{0};        ///< Sequence the block is ready for
+        FreePtr data;
+    };
+
+public:
+    /// @brief Reserved writable range in a block, committed once
+    class Slot
+    {
+    public:
+        Slot() = default;
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+
+        Slot(Slot&& other) noexcept { *this = std::move(other); }
+
+        Slot& operator=(Slot&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_owner != nullptr) { commit(0); }
+                m_owner = other.m_owner;
+                m_block = other.m_block;
+                m_start = other.m_start;
+                m_span = other.m_span;
+                other.m_owner = nullptr;
+            }
+            return *this;
+        }
+
+        /// Publish an empty record if not committed yet.
+        ~Slot()
+        {
+            if (m_owner != nullptr) { commit(0); }
+        }
+
+        explicit operator bool() const { return m_owner != nullptr; }
+
+        /// Start of the writable range.
+        char* data() const
+        {
+            return m_block->data.get() + (m_start & kBytesMask);
+        }
+
+        /// Writable bytes, excluding the '\0' kept by SlotView.
+        size_t capacity() const { return m_span - 1; }
+
+        /// Bounded view for SlotBuilder: `SlotBuilder builder(slot.view(), 0)`.
+        SlotView view() const { return SlotView(data(), m_span); }
+
+        /// @brief Publish the first `len` bytes written to data()
+        void commit(size_t len)
+        {
+            if (m_owner == nullptr) { return; }
+            if (len > capacity()) { len = 0; }
+            m_owner->Commit(*m_block, m_start, m_span, len);
+            m_owner = nullptr;
+        }
+
+        /// @brief Publish the result of a SlotBuilder, false if truncated
+        bool commit(SlotBuilder& builder)
+        {
+            const SlotView& json = builder.GetResult();
+            if (wwjson_unlikely(json.truncated()))
+            {
+                commit(0);
+                return false;
+            }
+            commit(json.size());
+            return true;
+        }
+
+    private:
+        friend class ConcurrentBuffer;
+        Slot(ConcurrentBuffer* owner, Block* block, uint64_t start, uint64_t span)
+            : m_owner(owner), m_block(block), m_start(start), m_span(span)
+        {
+        }
+
+        ConcurrentBuffer* m_owner = nullptr;
+        Block* m_block = nullptr;
+        uint64_t m_start = 0;   ///< Packed reservation word before this slot
+        uint64_t m_span = 0;    ///< Reserved bytes, including '\0'
+    };
+
+    /// @{ M0: Constructors
+
+    /// @brief Create `blocks` blocks of `block_size` bytes writing to `sink`
+    /// @details A single document must fit one block with its descriptor.
+    /// `block_size` is at most kMaxBlockSize (128 MiB).
+    explicit ConcurrentBuffer(FlushSink sink, size_t block_size = 256 * 1024,
+                              size_t blocks = 8)
+        : m_sink(std::move(sink)),
+          m_block_size(block_size),
+          m_count(blocks < 2 ? 2 : blocks)
+    {
+        assert(block_size > kEntrySize && block_size <= kMaxBlockSize);
+        m_blocks.reset(new Block[m_count]);
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            m_blocks[i].seq.store(i, std::memory_order_relaxed);
+            m_blocks[i].data.reset(static_cast<char*>(std::malloc(m_block_size)));
+            if (m_blocks[i].data == nullptr) { throw std::bad_alloc(); }
+        }
+    }
+
+    ConcurrentBuffer(const ConcurrentBuffer&) = delete;
+    ConcurrentBuffer& operator=(const ConcurrentBuffer&) = delete;
+
+    /// Write out what is committed, like FlushBuffer.
+    ~ConcurrentBuffer() { finish(); }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M1: Producer side (any thread)
+
+    /// @brief Reserve `max_len` bytes, empty Slot if the buffer is full
+    Slot reserve(size_t max_len)
+    {
+        uint64_t span = max_len + 1;  // with the '\0' kept by SlotView
+        if (wwjson_unlikely(max_len == 0 || span + kEntrySize > m_block_size))
+        {
+            return Slot();
+        }
+        for (;;)
+        {
+            uint64_t seq = m_current.load(std::memory_order_acquire);
+            Block& block = BlockOf(seq);
+            if (block.seq.load(std::memory_order_acquire) == seq &&
+                block.sealed.load(std::memory_order_relaxed) == kOpen)
+            {
+                uint64_t old = block.reserved.fetch_add(span + kCountOne,
+                                                        std::memory_order_acq_rel);
+                if (wwjson_likely(Footprint(old + span + kCountOne) <= m_block_size))
+                {
+                    return Slot(this, &block, old, span);
+                }
+                if (Footprint(old) <= m_block_size) { Seal(block, old); }
+            }
+            if (!Advance(seq)) { return Slot(); }
+        }
+    }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M2: Consumer side (one thread)
+
+    /// @brief Write completed blocks to the sink, return bytes written
+    /// @param force Also seal the current block if it holds any record
+    size_t flush(bool force = false)
+    {
+        size_t total = 0;
+        for (;;)
+        {
+            Block& block = BlockOf(m_flush_seq);
+            uint64_t sealed = block.sealed.load(std::memory_order_acquire);
+            if (sealed == kOpen)
+            {
+                if (!force || block.seq.load(std::memory_order_acquire) != m_flush_seq ||
+                    block.reserved.load(std::memory_order_acquire) == 0)
+                {
+                    break;
+                }
+                force = false;
+                uint64_t old = block.reserved.fetch_add(m_block_size + 1,
+                                                        std::memory_order_acq_rel);
+                if (Footprint(old) <= m_block_size) { Seal(block, old); }
+                Advance(m_flush_seq);
+                sealed = block.sealed.load(std::memory_order_acquire);
+                if (sealed == kOpen) { break; }
+            }
+            if (block.committed.load(std::memory_order_acquire) != sealed) { break; }
+            total += Write(block, sealed);
+            Recycle(block);
+        }
+        return total;
+    }
+
+    /// Seal and write everything committed, call after producers stop.
+    bool finish()
+    {
+        flush(true);
+        return !m_failed;
+    }
+
+    /// Total bytes passed to the sink successfully.
+    size_t flushed() const { return m_flushed; }
+
+    /// True once the sink has reported a failure (later output is dropped).
+    bool failed() const { return m_failed; }
+
+    /// @}
+
+private:
+    Block& BlockOf(uint64_t seq) const { return m_blocks[seq % m_count]; }
+
+    /// Payload bytes plus descriptors of a packed reservation word.
+    static uint64_t Footprint(uint64_t packed)
+    {
+        return (packed & kBytesMask) + (packed >> kCountShift) * kEntrySize;
+    }
+
+    static void Seal(Block& block, uint64_t packed)
+    {
+        block.sealed.store(packed, std::memory_order_release);
+    }
+
+    /// Move producers past block `seq`, false if the next one is not free.
+    bool Advance(uint64_t seq)
+    {
+        uint64_t next = seq + 1;
+        if (BlockOf(next).seq.load(std::memory_order_acquire) != next)
+        {
+            return m_current.load(std::memory_order_acquire) != seq;
+        }
+        m_current.compare_exchange_strong(seq, next, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void Commit(Block& block, uint64_t start, uint64_t span, size_t len)
+    {
+        uint64_t end = start + span + kCountOne;
+        uint64_t used = span;
+        if (len < span)
+        {
+            // give back the unused tail if still the last reservation
+            uint64_t shrunk = start + len + kCountOne;
+            if (block.reserved.compare_exchange_strong(end, shrunk,
+                                                       std::memory_order_acq_rel))
+            {
+                used = len;
+            }
+        }
+        uint32_t entry[2] = {static_cast<uint32_t>(start & kBytesMask),
+                             static_cast<uint32_t>(len)};
+        size_t index = static_cast<size_t>(start >> kCountShift);
+        ::memcpy(block.data.get() + m_block_size - (index + 1) * kEntrySize,
+                 entry, kEntrySize);
+        block.committed.fetch_add(used + kCountOne, std::memory_order_release);
+    }
+
+    /// Write records of a sealed block, merging adjacent ones into one call.
+    size_t Write(const Block& block, uint64_t sealed)
+    {
+        const char* base = block.data.get();
+        size_t count = static_cast<size_t>(sealed >> kCountShift);
+        size_t total = 0;
+        size_t run_begin = 0;
+        size_t run_end = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t entry[2];
+            ::memcpy(entry, base + m_block_size - (i + 1) * kEntrySize, kEntrySize);
+            if (entry[0] != run_end)
+            {
+                total += Emit(base + run_begin, run_end - run_begin);
+                run_begin = entry[0];
+                run_end = entry[0];
+            }
+            run_end += entry[1];
+        }
+        total += Emit(base + run_begin, run_end - run_begin);
+        return total;
+    }
+
+    size_t Emit(const char* data, size_t len)
+    {
+        if (len == 0 || m_failed) { return 0; }
+        if (!m_sink || !m_sink(data, len))
+        {
+            m_failed = true;
+            return 0;
+        }
+        m_flushed += len;
+        return len;
+    }
+
+    /// Reset a written block for its next turn in the ring.
+    void Recycle(Block& block)
+    {
+        block.committed.store(0, std::memory_order_relaxed);
+        block.sealed.store(kOpen, std::memory_order_relaxed);
+        block.reserved.store(0, std::memory_order_release);
+        block.seq.store(m_flush_seq + m_count, std::memory_order_release);
+        ++m_flush_seq;
+    }
+
+    FlushSink m_sink;
+    size_t m_block_size;
+    size_t m_count;
+    std::unique_ptr<Block[]> m_blocks;
+    std::atomic<uint64_t> m_current{0};  ///< Block sequence producers append to
+    uint64_t m_flush_seq = 0;            ///< Next block to write (consumer only)
+    size_t m_flushed = 0;
+    bool m_failed = false;
+};
+
+} // namespace wwjson
+
+#endif // JCONCURRENT_HPP__
@@ -0,0 +1,226 @@
+/**
+ * @file jcount.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Exact size measurement and two-pass serialization
+ *
+ * @details This header provides CountingString, a string type that only
+ * counts the bytes appended to it, and CountingConfig, which reproduces the
+ * escaping and number formatting of the library configs in measure-only
+ * mode. A GenericBuilder over them runs the same serialization code as the
+ * real builder and yields the exact output size, not an estimate.
+ *
+ * to_json_exact() uses it for two passes: measure first, then serialize
+ * into a single allocation of that size (or a caller buffer) with
+ * unchecked writes. The allocation adds a fixed margin for the scratch space
+ * of number formatting, so that it is never grown. This pays off when the output is large and made of few
+ * but long tokens, such as many large strings, where measuring is cheap and
+ * growth by reallocation would copy the content several times.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * size_t n = wwjson::measure_json(doc);        // exact length
+ * std::string json = wwjson::to_json_exact(doc); // one allocation
+ * ```
+ *
+ * @note Counting follows the standard escape table of BasicConfig and the
+ * number formatting of UnsafeConfig, so it is exact for the library configs.
+ * A custom config that overrides EscapeString or NumberString with a
+ * different output format is only approximated.
+ */
+
+#pragma once
+#ifndef JCOUNT_HPP__
+#define JCOUNT_HPP__
+
+#include "jbuilder.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace wwjson {
+
+/// @brief String type that counts appended bytes without storing them
+/// @details Only the last character is kept, since builders inspect and
+/// replace the tail (trailing comma before a closing bracket).
+class CountingString
+{
+public:
+    CountingString() = default;
+
+    void push_back(char c)
+    {
+        ++m_size;
+        m_back = c;
+    }
+
+    void append(const char* str, size_t len)
+    {
+        if (len == 0) { return; }
+        m_size += len;
+        m_back = str[len - 1];
+    }
+
+    void append(const char* str)
+    {
+        if (str == nullptr) { return; }
+        append(str, ::strlen(str));
+    }
+
+    void append(const std::string& str) { append(str.data(), str.size()); }
+    void append(const std::string_view& str) { append(str.data(), str.size()); }
+
+    /// Count `len` bytes whose content is not needed, ending with `last`.
+    void skip(size_t len, char last)
+    {
+        if (len == 0) { return; }
+        m_size += len;
+        m_back = last;
+    }
+
+    void pop_back()
+    {
+        if (m_size > 0) { --m_size; }
+        m_back = '\0';
+    }
+
+    char& back() { return m_back; }
+    char back() const { return m_back; }
+    size_t size() const { return m_size; }
+    size_t length() const { return m_size; }
+    size_t capacity() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    void reserve(size_t) {}
+    void clear()
+    {
+        m_size = 0;
+        m_back = '\0';
+    }
+
+private:
+    size_t m_size = 0;
+    char m_back = '\0';
+};
+
+/// @brief Measure-only counterpart of configT for CountingString
+/// @details Keeps the flags of configT. Escaping counts with the escape
+/// table instead of writing, numbers are formatted into a small stack
+/// buffer by UnsafeConfig so that the length is exact.
+template <typename configT = UnsafeConfig<KString>>
+struct CountingConfig : public BasicConfig<CountingString>
+{
+    static constexpr bool kEscapeKey = configT::kEscapeKey;
+    static constexpr bool kEscapeValue = configT::kEscapeValue;
+    static constexpr bool kQuoteNumber = configT::kQuoteNumber;
+    static constexpr bool kTailComma = configT::kTailComma;
+    static constexpr bool kValidateSub = configT::kValidateSub;
+
+    static void EscapeString(CountingString& dst, const char* src, size_t len)
+    {
+        if (wwjson_unlikely(src == nullptr || len == 0)) { return; }
+        size_t extra = 0;
+        for (size_t i = 0; i < len; ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(src[i]);
+            if (c < 128 && kEscapeTable[c] != 0) { ++extra; }
+        }
+        unsigned char last = static_cast<unsigned char>(src[len - 1]);
+        char back = (last < 128 && kEscapeTable[last] != 0)
+            ? static_cast<char>(kEscapeTable[last]) : static_cast<char>(last);
+        dst.skip(len + extra, back);
+    }
+
+    static void EscapeKey(CountingString& dst, const char* key, size_t len)
+    {
+        EscapeString(dst, key, len);
+    }
+
+    template <typename numberT>
+    static std::enable_if_t<std::is_arithmetic_v<numberT>, void>
+    NumberString(CountingString& dst, numberT value)
+    {
+        char buffer[128];
+        UnsafeBuffer view(buffer, sizeof(buffer));
+        UnsafeConfig<UnsafeBuffer>::NumberString(view, value);
+        dst.append(view.data(), view.size());
+    }
+};
+
+/// Builder that measures the output of GenericBuilder<*, configT>.
+template <typename configT = UnsafeConfig<KString>>
+using CountingBuilder = GenericBuilder<CountingString, CountingConfig<configT>>;
+
+/// @brief UnsafeConfig for caller memory of the measured size
+/// @details UnsafeConfig formats floats in place past the end of the string,
+/// trimming zeros afterwards, so it may touch a few bytes beyond the final
+/// text. Here floats go through a stack buffer, then only the measured bytes
+/// are copied.
+struct ViewConfig : public UnsafeConfig<UnsafeBuffer>
+{
+    template <typename numberT>
+    static std::enable_if_t<std::is_arithmetic_v<numberT>, void>
+    NumberString(UnsafeBuffer& dst, numberT value)
+    {
+        if constexpr (std::is_floating_point_v<numberT>)
+        {
+            char buffer[128];
+            UnsafeBuffer view(buffer, sizeof(buffer));
+            UnsafeConfig<UnsafeBuffer>::NumberString(view, value);
+            dst.append(view.data(), view.size());
+        }
+        else
+        {
+            UnsafeConfig<UnsafeBuffer>::NumberString(dst, value);
+        }
+    }
+};
+
+/// Builder writing into caller memory without bounds checks.
+using ViewBuilder = GenericBuilder<UnsafeBuffer, ViewConfig>;
+
+/// @brief Exact length of `wwjson::to_json(value)` written with configT
+template <typename configT = UnsafeConfig<KString>, typename valueT>
+size_t measure_json(const valueT& value)
+{
+    CountingBuilder<configT> counter;
+    to_json(counter, value);
+    return counter.GetResult().size();
+}
+
+/// @brief Serialize in two passes: measure, then write into one exact allocation
+/// @tparam resultT std::string (default), JString or ReleasedBuffer
+template <typename resultT = std::string, typename valueT>
+resultT to_json_exact(const valueT& value)
+{
+    CountingBuilder<> counter;
+    to_json(counter, value);
+    // with trailing comma, and the float scratch so that it never reallocates
+    FastBuilder builder(counter.json.size() + detail::kNumberReserve);
+    to_json(builder, value);
+    return detail::move_result<resultT>(builder);
+}
+
+/// @brief Serialize in two passes into caller memory
+/// @return JSON length n, written with '\0' only if `size >= n + 2` (one byte
+/// for the transient trailing comma, one for '\0'), otherwise nothing is
+/// written; no byte at or after `dst + n + 2` is touched
+template <typename valueT>
+size_t to_json_exact(const valueT& value, char* dst, size_t size)
+{
+    CountingBuilder<> counter;
+    to_json(counter, value);
+    size_t need = counter.json.size();  // with trailing comma
+    if (dst == nullptr || size <= need) { return counter.GetResult().size(); }
+
+    ViewBuilder builder(UnsafeBuffer(dst, size), 0);
+    to_json(builder, value);
+    UnsafeBuffer& json = builder.GetResult();
+    json.unsafe_end_cstr();
+    return json.size();
+}
+
+} // namespace wwjson
+
+#endif // JCOUNT_HPP__
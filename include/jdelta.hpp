@@ -0,0 +1,212 @@
+/**
+ * @file jdelta.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Incremental re-serialization of described structs
+ *
+ * @details This header provides DeltaJson, which keeps the JSON of a struct
+ * described by WWJSON_FIELDS between publishes, split into segments: the
+ * constant key fragments and one value segment per field. After some fields
+ * change, Update() serializes only the fields marked dirty:
+ * - a value of unchanged width is patched in place in the kept output;
+ * - otherwise the output is spliced again from the kept segments, which is
+ *   only memory copies, no serialization of the clean fields.
+ *
+ * The fields whose output actually changed are then known, and MergePatch()
+ * emits an RFC 7386 merge patch of just them, for sending deltas instead of
+ * whole documents.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * DeltaJson<State> delta;
+ * publish(delta.Build(state));        // first full document
+ * state.price = 12.5;
+ * delta.MarkDirty(&State::price);
+ * delta.Update(state);
+ * publish_patch(delta.MergePatch());  // {"price":12.5}
+ * ```
+ *
+ * @note In a merge patch, null removes the member. A field written as null
+ * (empty optional) thus appears removed to the receiver of the patch, and
+ * members dropped from a nested map are not removed, as the nested value is
+ * merged. Send the full json() when the receiver needs exact nulls.
+ */
+
+#pragma once
+#ifndef JDELTA_HPP__
+#define JDELTA_HPP__
+
+#include "jfields.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace wwjson {
+
+/// @brief Kept JSON of a described struct, re-serialized by dirty fields
+/// @tparam structT Type described by WWJSON_FIELDS
+/// @details Dirty fields are marked by the caller, by member pointer or field
+/// index, or all at once. A marked field whose output turns out the same is
+/// not counted as changed.
+template <typename structT>
+class DeltaJson
+{
+    static_assert(detail::has_fields_v<structT>, "DeltaJson needs a WWJSON_FIELDS type");
+    using fieldsT = std::decay_t<decltype(wwjson_fields(static_cast<const structT*>(nullptr)))>;
+
+public:
+    static constexpr size_t kCount = fieldsT::kCount;
+
+    DeltaJson() = default;
+
+    /// @brief Serialize all fields, discarding the kept output
+    /// @return The full JSON
+    const std::string& Build(const structT& value)
+    {
+        m_dirty = kAllFields;
+        m_changed = 0;
+        m_built = false;
+        return Update(value);
+    }
+
+    /// Mark field i for the next Update().
+    void MarkDirty(size_t i)
+    {
+        if (i < kCount) { m_dirty |= uint64_t(1) << i; }
+    }
+
+    /// Mark the field of a member pointer, as given to WWJSON_FIELDS.
+    template <typename memberT>
+    void MarkDirty(memberT structT::*member)
+    {
+        MarkMember(member, std::make_index_sequence<kCount>{});
+    }
+
+    void MarkAllDirty() { m_dirty = kAllFields; }
+
+    /// Fields marked dirty since the last Update().
+    uint64_t dirty() const { return m_dirty; }
+
+    /// @brief Re-serialize the dirty fields and patch the kept output
+    /// @return The full JSON, the same as wwjson::to_json(value)
+    const std::string& Update(const structT& value)
+    {
+        if (wwjson_unlikely(!m_built)) { m_dirty = kAllFields; }
+        m_changed = 0;
+        bool resized = !m_built;
+        UpdateEach(value, resized, std::make_index_sequence<kCount>{});
+        m_dirty = 0;
+        if (resized) { Splice(); }
+        m_built = true;
+        return m_json;
+    }
+
+    /// Full JSON of the last Build() or Update().
+    const std::string& json() const { return m_json; }
+
+    /// Fields whose output changed in the last Update(), bit i for field i.
+    uint64_t changed() const { return m_changed; }
+
+    /// Byte range of field i's value in json(), as {offset, length}.
+    std::pair<size_t, size_t> range(size_t i) const
+    {
+        return {m_pos[i], m_value[i].size()};
+    }
+
+    /// @brief RFC 7386 merge patch of the fields changed in the last Update()
+    /// @return `{}` if nothing changed
+    std::string MergePatch() const
+    {
+        const auto& fields = wwjson_fields(static_cast<const structT*>(nullptr));
+        std::string patch;
+        patch.push_back('{');
+        for (size_t i = 0; i < kCount; ++i)
+        {
+            if (!((m_changed >> i) & 1)) { continue; }
+            std::string_view frag = fields.fragment(i);
+            size_t skip = patch.size() == 1 ? 1 : 0;  // '{' or ',' of the first one
+            patch.append(frag.data() + skip, frag.size() - skip);
+            patch.append(m_value[i]);
+        }
+        patch.push_back('}');
+        return patch;
+    }
+
+private:
+    static constexpr uint64_t kAllFields =
+        kCount >= 64 ? ~uint64_t(0) : (uint64_t(1) << kCount) - 1;
+
+    template <typename memberT, size_t... Is>
+    void MarkMember(memberT structT::*member, std::index_sequence<Is...>)
+    {
+        const auto& fields = wwjson_fields(static_cast<const structT*>(nullptr));
+        auto mark = [&](size_t i, auto field) {
+            if constexpr (std::is_same_v<decltype(field), memberT structT::*>)
+            {
+                if (field == member) { m_dirty |= uint64_t(1) << i; }
+            }
+        };
+        (mark(Is, std::get<Is>(fields.members)), ...);
+    }
+
+    template <size_t... Is>
+    void UpdateEach(const structT& value, bool& resized, std::index_sequence<Is...>)
+    {
+        const auto& fields = wwjson_fields(static_cast<const structT*>(nullptr));
+        auto step = [&](size_t i, const auto& member) {
+            if (!((m_dirty >> i) & 1)) { return; }
+            m_scratch.json.clear();
+            detail::put_field_value(m_scratch, member);
+            const JString& out = m_scratch.GetResult();
+            std::string_view now(out.data(), out.size());
+            std::string& kept = m_value[i];
+            if (m_built && now == kept) { return; }
+
+            m_changed |= uint64_t(1) << i;
+            if (m_built && now.size() == kept.size())
+            {
+                m_json.replace(m_pos[i], now.size(), now.data(), now.size());
+            }
+            else
+            {
+                resized = true;
+            }
+            kept.assign(now.data(), now.size());
+        };
+        (step(Is, value.*std::get<Is>(fields.members)), ...);
+    }
+
+    /// Join the key fragments and value segments into the output again.
+    void Splice()
+    {
+        const auto& fields = wwjson_fields(static_cast<const structT*>(nullptr));
+        size_t total = fields.text.size();
+        for (const auto& value : m_value) { total += value.size(); }
+        m_json.clear();
+        m_json.reserve(total);
+        for (size_t i = 0; i < kCount; ++i)
+        {
+            std::string_view frag = fields.fragment(i);
+            m_json.append(frag.data(), frag.size());
+            m_pos[i] = m_json.size();
+            m_json.append(m_value[i]);
+        }
+        m_json.push_back('}');
+    }
+
+    std::string m_json;
+    std::array<std::string, kCount> m_value;  ///< Value segment of each field
+    std::array<size_t, kCount> m_pos{};       ///< Offset of each value in m_json
+    Builder m_scratch{256};
+    uint64_t m_dirty = 0;
+    uint64_t m_changed = 0;
+    bool m_built = false;
+};
+
+} // namespace wwjson
+
+#endif // JDELTA_HPP__
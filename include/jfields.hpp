@@ -0,0 +1,409 @@
+/**
+ * @file jfields.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Compile-time field descriptors with pre-serialized key fragments
+ *
+ * @details This header provides the WWJSON_FIELDS(Type, a, b, c) macro,
+ * which describes the members of a struct for serialization without a
+ * hand-written to_json method. The keys are turned into one constant text
+ * at compile time, with adjacent structural bytes merged into each fragment:
+ * ```
+ * {"a":  ,"b":  ,"c":  },
+ * ```
+ * so that the struct is written as alternating fragment copies and value
+ * writes, after one up-front reserve of the fragment bytes. Compared with a
+ * TO_JSON per field, this saves the strlen of each key and the separate
+ * quote, colon and comma pushes.
+ *
+ * A described type is picked up by wwjson::to_json and the to_json_impl
+ * rules like a struct with a to_json method, and can be nested in
+ * containers, optionals and other described types.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * namespace app {
+ * struct User { int id; std::string name; std::vector<int> roles; };
+ * WWJSON_FIELDS(User, id, name, roles)
+ * }
+ * std::string json = wwjson::to_json(user);
+ * ```
+ *
+ * When every member is bounded (integers, bools, floats, char arrays,
+ * std::array and optionals of them, or other such described types), the
+ * maximum serialized size is known at compile time as max_json_size_v<T>,
+ * and to_json_fast() writes into a FastBuilder of that capacity (plus the
+ * scratch margin of number formatting), without any growth check. Other types fall back to the growing Builder.
+ *
+ * @note Use the macro at namespace scope, in the namespace of the type (it
+ * defines a function found by argument-dependent lookup). Up to 64 fields.
+ */
+
+#pragma once
+#ifndef JFIELDS_HPP__
+#define JFIELDS_HPP__
+
+#include "jbuilder.hpp"
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace wwjson {
+
+/// @brief Constant description of a struct's serialized fields
+/// @tparam structT Described struct type
+/// @tparam N Total bytes of all key fragments
+/// @tparam memberTs Pointer-to-member types, in field order
+/// @details `text` holds kCount + 1 fragments back to back: `{"a":`, then
+/// `,"b":` for every further field, and `},` to close. `offset[i]` is the
+/// start of fragment i, `offset[kCount + 1]` the total size.
+template <typename structT, size_t N, typename... memberTs>
+struct FieldList
+{
+    static constexpr size_t kCount = sizeof...(memberTs);
+    static constexpr size_t kTextSize = N;
+    using members_type = std::tuple<memberTs...>;
+
+    std::array<char, N> text{};
+    std::array<uint32_t, kCount + 2> offset{};
+    std::tuple<memberTs...> members;
+
+    /// Fragment i (0 <= i <= kCount), the last one closes the object.
+    constexpr std::string_view fragment(size_t i) const
+    {
+        return std::string_view(text.data() + offset[i], offset[i + 1] - offset[i]);
+    }
+
+    /// Plain key name of field i, without quotes and separators.
+    constexpr std::string_view name(size_t i) const
+    {
+        std::string_view frag = fragment(i);
+        return frag.substr(2, frag.size() - 4);
+    }
+};
+
+namespace detail {
+
+/// @brief Join per-field key literals `,"a":` into a FieldList at compile time
+template <typename structT, typename... memberTs, size_t... Ns>
+constexpr auto make_fields(std::tuple<memberTs...> members, const char (&... keys)[Ns])
+{
+    static_assert(sizeof...(memberTs) == sizeof...(Ns), "one key per member");
+    constexpr size_t total = ((Ns - 1) + ... + 0) + 2;
+    FieldList<structT, total, memberTs...> fields{{}, {}, members};
+
+    size_t pos = 0;
+    size_t index = 0;
+    auto put = [&](const char* key, size_t len) {
+        fields.offset[index++] = static_cast<uint32_t>(pos);
+        for (size_t i = 0; i < len; ++i) { fields.text[pos++] = key[i]; }
+    };
+    (put(keys, Ns - 1), ...);
+    fields.text[0] = '{';  // the first fragment opens the object instead
+    put("},", 2);
+    fields.offset[index] = static_cast<uint32_t>(pos);
+    return fields;
+}
+
+/// @brief Write one field value without trailing comma when possible
+/// @return true if a trailing comma has been written (by the generic rules)
+/// @details Strings, numbers and bools follow GenericBuilder::AddItem
+/// exactly but leave the separator to the next fragment.
+template <typename builderT, typename valueT>
+bool put_field_value(builderT& builder, const valueT& value)
+{
+    using configT = typename builderT::config_type;
+    if constexpr (is_optional_v<valueT>)
+    {
+        if (value.has_value()) { return put_field_value(builder, value.value()); }
+        builder.PutNull();
+        return false;
+    }
+    else if constexpr (std::is_arithmetic_v<valueT>)
+    {
+        if constexpr (configT::kQuoteNumber)
+        {
+            builder.UnsafePutChar('"');
+            builder.PutValue(value);
+            builder.UnsafePutChar('"');
+        }
+        else
+        {
+            builder.PutValue(value);
+        }
+        return false;
+    }
+    else if constexpr (is_key_v<valueT>)
+    {
+        builder.PutValue(value);
+        return false;
+    }
+    else
+    {
+        to_json_impl(builder, NotKey{}, value);
+        return true;
+    }
+}
+
+template <typename builderT, typename structT, typename fieldsT, size_t... Is>
+void write_fields_each(builderT& builder, const structT& value, const fieldsT& fields,
+                       std::index_sequence<Is...>)
+{
+    bool comma = false;
+    auto step = [&](std::string_view frag, const auto& member) {
+        // the fragment begins with ',' except the first one
+        builder.Append(frag.data() + comma, frag.size() - comma);
+        comma = put_field_value(builder, member);
+    };
+    (step(fields.fragment(Is), value.*std::get<Is>(fields.members)), ...);
+
+    if (comma)
+    {
+        builder.EndObject();
+    }
+    else
+    {
+        std::string_view close = fields.fragment(fieldsT::kCount);
+        builder.Append(close.data(), close.size());
+    }
+}
+
+/// @brief Serialize a described struct as `{...},` (trailing comma like EndObject)
+template <typename builderT, typename structT>
+void write_fields(builderT& builder, const structT& value)
+{
+    const auto& fields = wwjson_fields(static_cast<const structT*>(nullptr));
+    using fieldsT = std::decay_t<decltype(fields)>;
+    builder.Reserve(fields.text.size());
+    write_fields_each(builder, value, fields, std::make_index_sequence<fieldsT::kCount>{});
+}
+
+/// @brief Maximum serialized size of a type, 0 with bounded == false if unknown
+/// @details Follows the to_json_impl rules, measured without trailing comma.
+template <typename T, typename configT, typename = void>
+struct max_json_size
+{
+    static constexpr bool bounded = false;
+    static constexpr size_t value = 0;
+};
+
+/// @brief Numbers: sign and digits, quotes if configured
+/// @details Floats take the longer of the two forms of NumberWriter. The
+/// fixed-point form has a sign, up to 16 integer digits (below 2^53), a point
+/// and up to four decimals, so a float such as `-8999999488000000.0` is
+/// longer than its shortest round-trip form (at most `-1.17549435e-38`). For
+/// double the shortest form, up to `-2.2250738585072014e-308`, is longer.
+template <typename T, typename configT>
+struct max_json_size<T, configT, std::enable_if_t<std::is_arithmetic_v<T>>>
+{
+    static constexpr size_t kFixedPoint = 1 + 16 + 1 + 4;
+
+    static constexpr size_t digits()
+    {
+        if constexpr (std::is_same_v<T, bool>) { return 5; }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            return std::numeric_limits<T>::digits10 + 1 + std::is_signed_v<T>;
+        }
+        else if constexpr (sizeof(T) <= sizeof(float)) { return kFixedPoint; }
+        else if constexpr (sizeof(T) <= sizeof(double)) { return 24; }
+        else { return 32; }
+    }
+
+    static constexpr bool bounded = true;
+    static constexpr size_t value = digits() + (configT::kQuoteNumber ? 2 : 0);
+};
+
+/// Bounded strings: char arrays, each byte escaped to at most two.
+template <size_t N, typename configT>
+struct max_json_size<char[N], configT>
+{
+    static constexpr bool bounded = true;
+    static constexpr size_t value = (N - 1) * (configT::kEscapeValue ? 2 : 1) + 2;
+};
+
+template <typename T, typename configT>
+struct max_json_size<std::optional<T>, configT>
+{
+    using inner = max_json_size<T, configT>;
+    static constexpr bool bounded = inner::bounded;
+    static constexpr size_t value = inner::value > 4 ? inner::value : 4;
+};
+
+template <typename T, size_t N, typename configT>
+struct max_json_size<std::array<T, N>, configT>
+{
+    using inner = max_json_size<T, configT>;
+    static constexpr bool bounded = inner::bounded;
+    static constexpr size_t value = 2 + N * inner::value + (N > 0 ? N - 1 : 0);
+};
+
+template <typename memberT>
+struct member_value;
+
+template <typename T, typename structT>
+struct member_value<T structT::*>
+{
+    using type = T;
+};
+
+/// Described structs: all key fragments plus each member's maximum.
+template <typename T, typename configT>
+struct max_json_size<T, configT, std::enable_if_t<has_fields_v<T>>>
+{
+    using fieldsT = std::decay_t<decltype(wwjson_fields(static_cast<const T*>(nullptr)))>;
+
+    template <typename... memberTs>
+    static constexpr bool all_bounded(std::tuple<memberTs...>*)
+    {
+        return (max_json_size<typename member_value<memberTs>::type, configT>::bounded && ...);
+    }
+
+    template <typename... memberTs>
+    static constexpr size_t sum_value(std::tuple<memberTs...>*)
+    {
+        return (max_json_size<typename member_value<memberTs>::type, configT>::value + ... + 0);
+    }
+
+    static constexpr typename fieldsT::members_type* kMembers = nullptr;
+    static constexpr bool bounded = all_bounded(kMembers);
+    static constexpr size_t value = fieldsT::kTextSize - 1 + sum_value(kMembers);
+};
+
+} // namespace detail
+
+/// @brief Compile-time maximum JSON size of T written with configT, 0 if unbounded
+template <typename T, typename configT = UnsafeConfig<KString>>
+inline constexpr size_t max_json_size_v = detail::max_json_size<std::remove_cv_t<T>, configT>::value;
+
+/// @brief Whether T has a compile-time bounded JSON size
+template <typename T, typename configT = UnsafeConfig<KString>>
+inline constexpr bool is_json_bounded_v = detail::max_json_size<std::remove_cv_t<T>, configT>::bounded;
+
+/// @brief Serialize with one exact allocation when the size is bounded
+/// @tparam resultT std::string (default), JString or ReleasedBuffer
+/// @details For a bounded type, allocate max_json_size_v<T> (plus the
+/// number scratch margin) once and write with FastBuilder, which never checks
+/// capacity. Otherwise the same as to_json with the growing Builder.
+template <typename resultT = std::string, typename valueT>
+resultT to_json_fast(const valueT& value)
+{
+    if constexpr (is_json_bounded_v<valueT>)
+    {
+        // with trailing comma, and the float scratch so that it never reallocates
+        FastBuilder builder(max_json_size_v<valueT> + 1 + detail::kNumberReserve);
+        to_json(builder, value);
+        return detail::move_result<resultT>(builder);
+    }
+    else
+    {
+        Builder builder;
+        to_json(builder, value);
+        return detail::move_result<resultT>(builder);
+    }
+}
+
+} // namespace wwjson
+
+// ============================================================================
+// WWJSON_FIELDS Macro - preprocessor helpers (up to 64 fields)
+// ============================================================================
+
+#define WWJSON_PP_EXPAND(x) x
+#define WWJSON_PP_CAT(a, b) WWJSON_PP_CAT_(a, b)
+#define WWJSON_PP_CAT_(a, b) a##b
+#define WWJSON_PP_ARG_N(_1,_2,_3,_4,_5,_6,_7,_8,_9,_10,_11,_12,_13,_14,_15,_16,_17,_18,_19,_20,_21,_22,_23,_24,_25,_26,_27,_28,_29,_30,_31,_32,_33,_34,_35,_36,_37,_38,_39,_40,_41,_42,_43,_44,_45,_46,_47,_48,_49,_50,_51,_52,_53,_54,_55,_56,_57,_58,_59,_60,_61,_62,_63,_64, N, ...) N
+#define WWJSON_PP_NARG(...) WWJSON_PP_EXPAND(WWJSON_PP_ARG_N(__VA_ARGS__, 64,63,62,61,60,59,58,57,56,55,54,53,52,51,50,49,48,47,46,45,44,43,42,41,40,39,38,37,36,35,34,33,32,31,30,29,28,27,26,25,24,23,22,21,20,19,18,17,16,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1))
+#define WWJSON_PP_FE_1(m, t, x) m(t, x)
+#define WWJSON_PP_FE_2(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_1(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_3(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_2(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_4(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_3(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_5(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_4(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_6(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_5(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_7(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_6(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_8(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_7(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_9(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_8(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_10(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_9(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_11(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_10(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_12(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_11(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_13(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_12(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_14(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_13(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_15(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_14(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_16(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_15(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_17(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_16(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_18(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_17(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_19(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_18(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_20(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_19(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_21(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_20(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_22(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_21(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_23(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_22(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_24(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_23(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_25(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_24(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_26(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_25(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_27(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_26(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_28(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_27(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_29(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_28(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_30(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_29(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_31(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_30(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_32(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_31(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_33(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_32(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_34(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_33(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_35(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_34(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_36(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_35(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_37(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_36(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_38(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_37(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_39(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_38(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_40(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_39(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_41(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_40(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_42(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_41(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_43(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_42(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_44(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_43(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_45(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_44(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_46(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_45(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_47(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_46(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_48(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_47(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_49(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_48(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_50(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_49(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_51(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_50(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_52(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_51(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_53(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_52(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_54(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_53(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_55(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_54(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_56(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_55(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_57(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_56(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_58(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_57(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_59(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_58(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_60(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_59(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_61(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_60(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_62(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_61(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_63(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_62(m, t, __VA_ARGS__))
+#define WWJSON_PP_FE_64(m, t, x, ...) m(t, x), WWJSON_PP_EXPAND(WWJSON_PP_FE_63(m, t, __VA_ARGS__))
+#define WWJSON_PP_FOR_EACH(m, t, ...) \
+    WWJSON_PP_EXPAND(WWJSON_PP_CAT(WWJSON_PP_FE_, WWJSON_PP_NARG(__VA_ARGS__))(m, t, __VA_ARGS__))
+
+#define WWJSON_FIELD_MEMBER_(Type, field) &Type::field
+#define WWJSON_FIELD_KEY_(Type, field) ",\"" #field "\":"
+
+/// @brief Describe serialized fields of `Type`, in output order
+/// @details Defines `wwjson_fields(const Type*)` returning a constant
+/// FieldList, found by wwjson through argument-dependent lookup.
+#ifndef WWJSON_FIELDS
+#define WWJSON_FIELDS(Type, ...)                                                   \
+    inline const auto& wwjson_fields(const Type*)                                  \
+    {                                                                              \
+        static constexpr auto fields = ::wwjson::detail::make_fields<Type>(        \
+            std::make_tuple(WWJSON_PP_FOR_EACH(WWJSON_FIELD_MEMBER_, Type, __VA_ARGS__)), \
+            WWJSON_PP_FOR_EACH(WWJSON_FIELD_KEY_, Type, __VA_ARGS__));             \
+        return fields;                                                             \
+    }
+#else
+#pragma message("WARNING: WWJSON_FIELDS macro is already defined elsewhere")
+#endif
+
+#endif // JFIELDS_HPP__
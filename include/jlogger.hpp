@@ -0,0 +1,512 @@
+/**
+ * @file jlogger.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Structured NDJSON logging with per-thread buffers and a writer thread
+ *
+ * @details This header provides Logger, which formats each log call as one
+ * JSON line with a thread-local Builder, so the hot path takes no lock and
+ * makes no system call. A filled buffer is handed to a background writer
+ * through a lock-free multi-producer queue, and the writer outputs all
+ * pending buffers with one batched writev (or one sink call per buffer).
+ *
+ * Line format, with the fields written by the caller's callable last:
+ * ```
+ * {"ts":1760745600123456,"level":"info","msg":"login","user":42}
+ * ```
+ *
+ * @note Requires linking with the platform thread library (Threads::Threads
+ * in CMake).
+ */
+
+#pragma once
+#ifndef JLOGGER_HPP__
+#define JLOGGER_HPP__
+
+#include "jsink.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <climits>
+#include <sys/uio.h>
+#endif
+
+namespace wwjson {
+
+/// @brief Severity of a log line, written as the "level" member
+enum class LogLevel : uint8_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Fatal,
+};
+
+/// @brief Lower case name of a log level
+inline const char* LogLevelName(LogLevel level)
+{
+    static const char* const names[] = {"trace", "debug", "info", "warn", "error", "fatal"};
+    return names[static_cast<uint8_t>(level) % 6];
+}
+
+/// @brief Tuning of a Logger
+struct LoggerOptions
+{
+    /// Per-thread buffer size; a buffer past it is handed to the writer.
+    size_t buffer_size = 64 * 1024;
+    /// Buffers waiting for the writer before backpressure applies.
+    size_t max_pending = 64;
+    /// When the queue is full: wait for the writer (true) or drop lines (false).
+    bool block = false;
+    /// Lines below this level are skipped.
+    LogLevel level = LogLevel::Info;
+    /// Lines of this level or above are handed off at once.
+    LogLevel flush_level = LogLevel::Error;
+    /// Write "ts" as microseconds since epoch.
+    bool timestamp = true;
+    /// Writer wakeup period; a thread hands off its buffer on the next
+    /// log call after each period, so lines are not held indefinitely.
+    std::chrono::milliseconds interval{100};
+};
+
+/// @brief Thread-safe NDJSON logger with a background writer thread
+/// @details
+/// Each thread that logs gets its own Builder (registered once per thread
+/// and logger). A log call writes one line into it and returns; no lock is
+/// taken. Buffers are handed off when past `buffer_size`, for lines of
+/// `flush_level` or above, on the first call after each writer `interval`,
+/// on Flush(), and when the thread exits.
+///
+/// @par Backpressure:
+/// At most `max_pending` buffers wait for the writer. Beyond that a thread
+/// whose buffer is full either drops new lines (counted by dropped()), or
+/// with `block` yields until the writer catches up.
+///
+/// @par Usage Example:
+/// ```cpp
+/// Logger logger(STDOUT_FILENO);
+/// logger.Log(LogLevel::Info, "login", [&](Builder& b) {
+///     b.AddMember("user", user_id);
+///     b.AddMember("ip", ip);
+/// });
+/// logger.Warn("disk almost full");
+/// ```
+///
+/// @note Stop logging through a Logger before destroying it; the destructor
+/// hands off the buffers of all threads and writes everything.
+class Logger
+{
+    /// Buffer handed to the writer, linked in the lock-free queue.
+    struct Batch
+    {
+        JString data;
+        Batch* next = nullptr;
+    };
+
+    /// Per-thread line buffer of one logger.
+    struct ThreadBuffer
+    {
+        std::atomic<Logger*> owner{nullptr};
+        Builder builder;
+        uint64_t epoch = 0;
+
+        ThreadBuffer(Logger* logger, size_t capacity)
+            : owner(logger), builder(capacity)
+        {
+        }
+    };
+
+    /// Thread-local list of buffers, handed off when the thread exits.
+    struct ThreadSlots
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+        ~ThreadSlots()
+        {
+            std::lock_guard<std::mutex> lock(RegistryMutex());
+            for (auto& buffer : buffers)
+            {
+                Logger* owner = buffer->owner.load(std::memory_order_relaxed);
+                if (owner != nullptr) { owner->Detach(buffer); }
+            }
+        }
+    };
+
+public:
+    /// @{ M0: Constructors
+
+#if defined(__unix__) || defined(__APPLE__)
+    /// @brief Log to a file descriptor (not closed) with batched writev
+    explicit Logger(int fd, LoggerOptions options = LoggerOptions())
+        : m_options(options), m_fd(fd)
+    {
+        Start();
+    }
+#endif
+
+    /// @brief Log to a sink, called once per handed-off buffer
+    explicit Logger(FlushSink sink, LoggerOptions options = LoggerOptions())
+        : m_options(options), m_sink(std::move(sink))
+    {
+        Start();
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    ~Logger()
+    {
+        {
+            std::lock_guard<std::mutex> lock(RegistryMutex());
+            for (auto& buffer : m_threads)
+            {
+                HandOff(*buffer, true);
+                buffer->owner.store(nullptr, std::memory_order_relaxed);
+            }
+            m_threads.clear();
+        }
+        m_stop.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_all();
+        }
+        if (m_writer.joinable()) { m_writer.join(); }
+    }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M1: Logging (any thread)
+
+    /// @brief Write one line, `fields(builder)` adds extra members
+    /// @return false if the level is filtered or the line is dropped
+    template <typename fieldsT>
+    bool Log(LogLevel level, std::string_view msg, fieldsT&& fields)
+    {
+        if (level < m_level.load(std::memory_order_relaxed)) { return false; }
+        ThreadBuffer& local = Local();
+        Builder& builder = local.builder;
+        if (wwjson_unlikely(builder.Size() >= m_options.buffer_size) &&
+            !HandOff(local, false))
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        builder.BeginObject();
+        if (m_options.timestamp) { builder.AddMember("ts", NowMicros()); }
+        builder.AddMember("level", LogLevelName(level));
+        builder.AddMemberEscape("msg", msg);
+        fields(builder);
+        builder.EndObject();
+        builder.GetResult();
+        builder.PutChar('\n');
+
+        uint64_t epoch = m_epoch.load(std::memory_order_relaxed);
+        if (wwjson_unlikely(level >= m_options.flush_level || local.epoch != epoch))
+        {
+            local.epoch = epoch;
+            HandOff(local, level >= m_options.flush_level);
+        }
+        return true;
+    }
+
+    bool Log(LogLevel level, std::string_view msg)
+    {
+        return Log(level, msg, [](Builder&) {});
+    }
+
+    template <typename... Args> bool Debug(Args&&... args)
+    {
+        return Log(LogLevel::Debug, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> bool Info(Args&&... args)
+    {
+        return Log(LogLevel::Info, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> bool Warn(Args&&... args)
+    {
+        return Log(LogLevel::Warn, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> bool Error(Args&&... args)
+    {
+        return Log(LogLevel::Error, std::forward<Args>(args)...);
+    }
+
+    /// @brief Hand off this thread's buffer and wait until it is written
+    void Flush()
+    {
+        ThreadBuffer& local = Local();
+        HandOff(local, true);
+        uint64_t target = m_queued.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.notify_all();
+        m_done.wait(lock, [&] {
+            return m_done_count.load(std::memory_order_acquire) >= target;
+        });
+    }
+
+    /// Change the minimum level at runtime.
+    void SetLevel(LogLevel level) { m_level.store(level, std::memory_order_relaxed); }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M2: Statistics
+
+    /// Lines dropped because the writer queue was full.
+    size_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// Bytes written successfully by the writer thread.
+    size_t written() const { return m_written.load(std::memory_order_relaxed); }
+
+    /// True once an output error has happened (later output is discarded).
+    bool failed() const { return m_failed.load(std::memory_order_relaxed); }
+
+    /// @}
+
+private:
+    /// Guards thread registration of all loggers, taken once per thread.
+    static std::mutex& RegistryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static uint64_t NowMicros()
+    {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    void Start()
+    {
+        m_level.store(m_options.level, std::memory_order_relaxed);
+        m_writer = std::thread([this] { Run(); });
+    }
+
+    /// Buffer of the calling thread, registered on first use.
+    ThreadBuffer& Local()
+    {
+        thread_local ThreadSlots slots;
+        for (auto& buffer : slots.buffers)
+        {
+            if (wwjson_likely(buffer->owner.load(std::memory_order_relaxed) == this))
+            {
+                return *buffer;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        auto& list = slots.buffers;
+        for (size_t i = 0; i < list.size();)
+        {
+            // drop buffers of destroyed loggers
+            if (list[i]->owner.load(std::memory_order_relaxed) == nullptr)
+            {
+                list[i] = std::move(list.back());
+                list.pop_back();
+            }
+            else { ++i; }
+        }
+        auto buffer = std::make_shared<ThreadBuffer>(this, m_options.buffer_size);
+        buffer->epoch = m_epoch.load(std::memory_order_relaxed);
+        m_threads.push_back(buffer);
+        list.push_back(buffer);
+        return *list.back();
+    }
+
+    /// Called with RegistryMutex held when a logging thread exits.
+    void Detach(const std::shared_ptr<ThreadBuffer>& buffer)
+    {
+        HandOff(*buffer, true);
+        buffer->owner.store(nullptr, std::memory_order_relaxed);
+        for (auto& item : m_threads)
+        {
+            if (item == buffer)
+            {
+                item = std::move(m_threads.back());
+                m_threads.pop_back();
+                break;
+            }
+        }
+    }
+
+    /// @brief Push the thread buffer to the writer queue
+    /// @param force Ignore `max_pending` (flush, shutdown and urgent lines)
+    /// @return false if the queue is full and lines should be dropped
+    bool HandOff(ThreadBuffer& local, bool force)
+    {
+        JString& json = local.builder.json;
+        if (json.empty()) { return true; }
+        if (!force && m_pending.load(std::memory_order_acquire) >= m_options.max_pending)
+        {
+            if (!m_options.block) { return false; }
+            while (m_pending.load(std::memory_order_acquire) >= m_options.max_pending)
+            {
+                m_cv.notify_one();
+                std::this_thread::yield();
+            }
+        }
+
+        Batch* batch = new Batch{std::move(json), nullptr};
+        json = JString(m_options.buffer_size);
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        m_queued.fetch_add(1, std::memory_order_release);
+        Batch* head = m_queue.load(std::memory_order_relaxed);
+        do
+        {
+            batch->next = head;
+        } while (!m_queue.compare_exchange_weak(head, batch, std::memory_order_release,
+                                                std::memory_order_relaxed));
+        if (m_idle.load(std::memory_order_acquire)) { m_cv.notify_one(); }
+        return true;
+    }
+
+    /// Writer thread: take the whole queue, write it, sleep when empty.
+    void Run()
+    {
+        using clock = std::chrono::steady_clock;
+        auto tick = clock::now() + m_options.interval;
+        std::vector<Batch*> batches;
+        for (;;)
+        {
+            Batch* list = m_queue.exchange(nullptr, std::memory_order_acquire);
+            if (list != nullptr)
+            {
+                // the queue is LIFO: reverse to keep each thread's order
+                batches.clear();
+                for (; list != nullptr; list = list->next) { batches.push_back(list); }
+                std::reverse(batches.begin(), batches.end());
+                Write(batches);
+                for (Batch* batch : batches) { delete batch; }
+                m_pending.fetch_sub(batches.size(), std::memory_order_release);
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_done_count.fetch_add(batches.size(), std::memory_order_release);
+                }
+                m_done.notify_all();
+                continue;
+            }
+            if (m_stop.load(std::memory_order_acquire))
+            {
+                // buffers handed off by the destructor are visible now
+                if (m_queue.load(std::memory_order_acquire) == nullptr) { break; }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.store(true, std::memory_order_release);
+            m_cv.wait_until(lock, tick, [this] {
+                return m_queue.load(std::memory_order_acquire) != nullptr ||
+                       m_stop.load(std::memory_order_acquire);
+            });
+            m_idle.store(false, std::memory_order_relaxed);
+            if (clock::now() >= tick)
+            {
+                m_epoch.fetch_add(1, std::memory_order_relaxed);
+                tick = clock::now() + m_options.interval;
+            }
+        }
+    }
+
+    void Write(const std::vector<Batch*>& batches)
+    {
+        if (m_failed.load(std::memory_order_relaxed)) { return; }
+#if defined(__unix__) || defined(__APPLE__)
+        if (m_fd >= 0)
+        {
+            WriteFd(batches);
+            return;
+        }
+#endif
+        for (Batch* batch : batches)
+        {
+            if (!m_sink || !m_sink(batch->data.data(), batch->data.size()))
+            {
+                m_failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            m_written.fetch_add(batch->data.size(), std::memory_order_relaxed);
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    /// Write all batches with writev, at most IOV_MAX buffers per call.
+    void WriteFd(const std::vector<Batch*>& batches)
+    {
+        std::vector<struct iovec> iov;
+        iov.reserve(batches.size());
+        for (Batch* batch : batches)
+        {
+            iov.push_back({const_cast<char*>(batch->data.data()), batch->data.size()});
+        }
+
+        size_t index = 0;
+        while (index < iov.size())
+        {
+            int count = static_cast<int>(std::min<size_t>(iov.size() - index, IOV_MAX));
+            ssize_t n = ::writev(m_fd, &iov[index], count);
+            if (n < 0)
+            {
+                if (errno == EINTR) { continue; }
+                m_failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            m_written.fetch_add(static_cast<size_t>(n), std::memory_order_relaxed);
+            // skip fully written buffers, then resume a partial one
+            size_t left = static_cast<size_t>(n);
+            while (index < iov.size() && left >= iov[index].iov_len)
+            {
+                left -= iov[index].iov_len;
+                ++index;
+            }
+            if (left > 0)
+            {
+                iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + left;
+                iov[index].iov_len -= left;
+            }
+        }
+    }
+#endif
+
+    LoggerOptions m_options;
+    FlushSink m_sink;
+    int m_fd = -1;
+    std::atomic<LogLevel> m_level{LogLevel::Info};
+
+    std::vector<std::shared_ptr<ThreadBuffer>> m_threads;  ///< Under RegistryMutex
+    std::atomic<Batch*> m_queue{nullptr};   ///< Lock-free LIFO of handed-off buffers
+    std::atomic<size_t> m_pending{0};       ///< Buffers not written yet
+    std::atomic<uint64_t> m_queued{0};      ///< Buffers handed off in total
+    std::atomic<uint64_t> m_done_count{0};  ///< Buffers written in total
+    std::atomic<uint64_t> m_epoch{0};       ///< Bumped every writer interval
+    std::atomic<size_t> m_dropped{0};
+    std::atomic<size_t> m_written{0};
+    std::atomic<bool> m_failed{false};
+    std::atomic<bool> m_idle{false};
+    std::atomic<bool> m_stop{false};
+
+    std::mutex m_mutex;                  ///< Only for writer sleep and Flush wait
+    std::condition_variable m_cv;        ///< Wakes the writer
+    std::condition_variable m_done;      ///< Signals written buffers to Flush
+    std::thread m_writer;
+};
+
+} // namespace wwjson
+
+#endif // JLOGGER_HPP__
@@ -0,0 +1,480 @@
+/**
+ * @file jparallel.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Parallel JSON serialization of large arrays and object members
+ *
+ * @details This header provides a small ThreadPool and to_json_parallel(),
+ * which splits a random-access container into chunks, serializes each chunk
+ * into its own builder on a worker thread, and gathers the chunks in order.
+ * The output is byte-identical to the serial wwjson::to_json path, because
+ * every array item is written position-independently as `item,` and the
+ * enclosing brackets are added by the target builder.
+ *
+ * AsyncObject extends the same idea to objects: expensive members are built
+ * by sub-builders on the pool and spliced back in declaration order.
+ *
+ * @note Requires linking with the platform thread library (Threads::Threads
+ * in CMake). The pool is not used by any other header.
+ */
+
+#pragma once
+#ifndef JPARALLEL_HPP__
+#define JPARALLEL_HPP__
+
+#include "jbuilder.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wwjson {
+
+/// @brief Fixed-size thread pool running `void()` tasks in FIFO order
+/// @details A pool of 0 threads runs every task inline in submit(), which is
+/// convenient to compare against the serial path with the same code.
+class ThreadPool
+{
+public:
+    /// @brief Start `threads` workers (default: hardware concurrency - 1,
+    /// leaving one core for the submitting thread).
+    explicit ThreadPool(size_t threads = DefaultThreads())
+    {
+        m_workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+        {
+            m_workers.emplace_back([this] { Run(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Finish queued tasks, then join workers.
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cond.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    /// Number of worker threads (the caller may work as an extra one).
+    size_t size() const { return m_workers.size(); }
+
+    /// @brief Queue a task, return future to wait for it (or its exception)
+    template <typename funcT>
+    std::future<void> submit(funcT&& task)
+    {
+        auto packaged = std::make_shared<std::packaged_task<void()>>(std::forward<funcT>(task));
+        std::future<void> result = packaged->get_future();
+        if (m_workers.empty())
+        {
+            (*packaged)();
+            return result;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace_back([packaged] { (*packaged)(); });
+        }
+        m_cond.notify_one();
+        return result;
+    }
+
+    static size_t DefaultThreads()
+    {
+        size_t hc = std::thread::hardware_concurrency();
+        return hc > 1 ? hc - 1 : 0;
+    }
+
+private:
+    void Run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cond.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                if (m_tasks.empty()) { return; }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_stop = false;
+};
+
+namespace detail {
+
+/// Minimal number of items per chunk, smaller ranges are not split.
+constexpr size_t kParallelMinChunk = 256;
+
+/// Chunks per participating thread, for load balance of uneven items.
+constexpr size_t kParallelChunksPerThread = 4;
+
+/// @brief Serialize items of a random-access container in parallel
+/// @details Writes `item,` for each element into the target builder, the
+/// same bytes as the serial loop in to_json_impl. Chunk 0 is written
+/// directly into the target by the calling thread; the rest go to
+/// per-chunk builders on the pool and are appended in order (gather-copy).
+/// Chunk builders grow in memory with the config flags of builderT, see
+/// growing_builder_t, also when the target cannot grow or flushes.
+template <typename builderT, typename containerT>
+void to_json_items_parallel(builderT& builder, const containerT& value,
+                            ThreadPool& pool, size_t min_chunk)
+{
+    auto first = std::begin(value);
+    size_t count = static_cast<size_t>(std::distance(first, std::end(value)));
+    if (min_chunk == 0) { min_chunk = kParallelMinChunk; }
+
+    size_t max_chunks = (pool.size() + 1) * kParallelChunksPerThread;
+    size_t chunks = count / min_chunk;
+    if (chunks > max_chunks) { chunks = max_chunks; }
+    if (chunks <= 1 || pool.size() == 0)
+    {
+        for (const auto& elem : value)
+        {
+            to_json_impl(builder, NotKey{}, elem);
+        }
+        return;
+    }
+
+    size_t step = count / chunks;
+    size_t extra = count % chunks;
+    std::vector<size_t> bounds(chunks + 1, 0);
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        bounds[i + 1] = bounds[i] + step + (i < extra ? 1 : 0);
+    }
+
+    using partT = growing_builder_t<builderT>;
+    std::vector<std::unique_ptr<partT>> parts(chunks);
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks - 1);
+    for (size_t i = 1; i < chunks; ++i)
+    {
+        futures.push_back(pool.submit([&parts, &bounds, first, i] {
+            auto part = std::make_unique<partT>();
+            auto it = std::next(first, static_cast<std::ptrdiff_t>(bounds[i]));
+            for (size_t k = bounds[i]; k < bounds[i + 1]; ++k, ++it)
+            {
+                to_json_impl(*part, NotKey{}, *it);
+            }
+            parts[i] = std::move(part);
+        }));
+    }
+
+    // The calling thread does chunk 0 in place while workers run.
+    std::exception_ptr error;
+    try
+    {
+        auto it = first;
+        for (size_t k = 0; k < bounds[1]; ++k, ++it)
+        {
+            to_json_impl(builder, NotKey{}, *it);
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // Wait all before gathering or rethrowing: tasks refer to local state.
+    for (auto& future : futures)
+    {
+        future.wait();
+    }
+    for (auto& future : futures)
+    {
+        try
+        {
+            future.get();
+        }
+        catch (...)
+        {
+            if (!error) { error = std::current_exception(); }
+        }
+    }
+    if (error) { std::rethrow_exception(error); }
+
+    size_t total = 0;
+    for (size_t i = 1; i < chunks; ++i)
+    {
+        total += parts[i]->Size();
+    }
+    builder.Reserve(total);
+    for (size_t i = 1; i < chunks; ++i)
+    {
+        builder.Append(parts[i]->json.data(), parts[i]->Size());
+    }
+}
+
+} // namespace detail
+
+/// @brief Serialize a large array in parallel, as array item
+/// @tparam builderT GenericBuilder type; chunks use a growing builder with
+/// its config flags
+/// @tparam containerT Random-access container (std::vector, std::array, std::deque)
+/// @param builder Target builder
+/// @param value Container to serialize
+/// @param pool Thread pool providing workers
+/// @param min_chunk Minimal items per chunk (0 for default)
+/// @note Output is identical to wwjson::to_json(builder, value).
+template <typename builderT, typename containerT>
+void to_json_parallel(builderT& builder, const containerT& value,
+                      ThreadPool& pool, size_t min_chunk = 0)
+{
+    static_assert(detail::is_vector_v<containerT>,
+        "to_json_parallel requires a sequence container");
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+        typename std::iterator_traits<decltype(std::begin(value))>::iterator_category>,
+        "to_json_parallel requires random-access iterators");
+
+    builder.BeginArray();
+    detail::to_json_items_parallel(builder, value, pool, min_chunk);
+    builder.EndArray();
+}
+
+/// @brief Serialize a large array in parallel, as object member
+/// @note Output is identical to wwjson::to_json(builder, key, value).
+template <typename builderT, typename containerT>
+void to_json_parallel(builderT& builder, const char* key, const containerT& value,
+                      ThreadPool& pool, size_t min_chunk = 0)
+{
+    builder.AddMember(key);
+    to_json_parallel(builder, value, pool, min_chunk);
+}
+
+/// @brief Serialize a large array to JSON string using default Builder
+/// @tparam resultT std::string (default), JString or ReleasedBuffer, as to_json
+template <typename resultT = std::string, typename containerT>
+resultT to_json_parallel(const containerT& value, ThreadPool& pool, size_t min_chunk = 0)
+{
+    Builder builder;
+    to_json_parallel(builder, value, pool, min_chunk);
+    return detail::move_result<resultT>(builder);
+}
+
+namespace detail {
+
+/// String types holding the whole document in memory, as AsyncObject needs.
+template <typename stringT>
+struct is_memory_string : is_growing_string<stringT> {};
+
+template <UnsafeLevel LEVEL>
+struct is_memory_string<StringBuffer<LEVEL>> : std::true_type {};
+
+} // namespace detail
+
+/// @brief Scoped object whose selected members are built concurrently
+/// @tparam builderT GenericBuilder type of the parent, over std::string or
+/// StringBuffer; sub-builders are `sub_builder`, growing with its config flags
+/// @details
+/// Like GenericObject, the constructor begins an object and End() (or the
+/// destructor) ends it. AddMemberAsync(key, func) writes the key at once and
+/// runs `func(sub)` on the pool to build the value into its own sub-builder.
+/// Ordinary members may be added in between as usual. At End(), after all
+/// tasks finish, each value is spliced into the parent at the position of its
+/// key, so the output equals the serial construction in declaration order.
+///
+/// @par Splice Algorithm:
+/// The parent is resized once by the total size of the values, then the
+/// segments between async members are moved backward (last first) and each
+/// value is copied into its gap, so every byte moves at most once.
+///
+/// @par Usage Example:
+/// @code
+/// ThreadPool pool;
+/// Builder builder;
+/// {
+///     AsyncObject<Builder> obj(builder, pool);
+///     obj.AddMember("id", 1);
+///     obj.AddMemberAsync("stats", [&](Builder& sub) { to_json(sub, stats); });
+///     obj.AddMember("name", "aggregate");
+/// } // {"id":1,"stats":{...},"name":"aggregate"}
+/// @endcode
+///
+/// @note The parent must hold the whole document in memory (not FlushBuilder),
+/// which is checked at compile time. A value writing nothing or throwing
+/// becomes `null`; End() rethrows the first exception after the object is
+/// closed.
+template <typename builderT>
+class AsyncObject
+{
+    static_assert(detail::is_memory_string<typename builderT::string_type>::value,
+        "AsyncObject splices values into the parent, which must hold the whole document");
+
+public:
+    /// Builder of async member values, `builderT` itself unless it cannot grow.
+    using sub_builder = detail::growing_builder_t<builderT>;
+
+    /// Begin an object without key.
+    AsyncObject(builderT& builder, ThreadPool& pool)
+        : m_builder(builder), m_pool(pool)
+    {
+        m_builder.BeginObject();
+    }
+
+    /// Begin an object as member `key` of the current object.
+    template <typename keyT>
+    AsyncObject(builderT& builder, ThreadPool& pool, keyT&& key)
+        : m_builder(builder), m_pool(pool)
+    {
+        m_builder.PutKey(std::forward<keyT>(key));
+        m_builder.BeginObject();
+    }
+
+    AsyncObject(const AsyncObject&) = delete;
+    AsyncObject& operator=(const AsyncObject&) = delete;
+
+    /// End the object if End() is not called, ignoring task exceptions.
+    ~AsyncObject()
+    {
+        if (!m_ended)
+        {
+            try { End(); } catch (...) {}
+        }
+    }
+
+    template <typename... Args> void AddMember(Args&&... args)
+    {
+        m_builder.AddMember(std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> void AddMemberEscape(Args&&... args)
+    {
+        m_builder.AddMemberEscape(std::forward<Args>(args)...);
+    }
+
+    template <typename... Args> void AddMemberSub(Args&&... args)
+    {
+        m_builder.AddMemberSub(std::forward<Args>(args)...);
+    }
+
+    /// @brief Add member whose value is built by `func(sub_builder&)` on the pool
+    /// @details `func` writes exactly one JSON value into the sub-builder,
+    /// e.g. BeginObject()...EndObject(), or a to_json() call without key.
+    template <typename keyT, typename funcT>
+    void AddMemberAsync(keyT&& key, funcT&& func)
+    {
+        m_builder.PutKey(std::forward<keyT>(key));
+        auto task = std::make_unique<Task>();
+        task->offset = m_builder.Size();
+        Task* raw = task.get();
+        task->future = m_pool.submit(
+            [raw, fn = std::forward<funcT>(func)]() mutable {
+                try
+                {
+                    fn(raw->sub);
+                }
+                catch (...)
+                {
+                    raw->error = std::current_exception();
+                }
+            });
+        m_tasks.push_back(std::move(task));
+        m_builder.SepItem();
+    }
+
+    /// Direct access to the parent builder for other operations.
+    builderT& operator[](int /* index */) { return m_builder; }
+
+    /// @brief Wait tasks, splice values in order and end the object
+    void End()
+    {
+        if (m_ended) { return; }
+        m_ended = true;
+
+        for (auto& task : m_tasks)
+        {
+            task->future.wait();
+        }
+
+        std::exception_ptr error;
+        size_t extra = 0;
+        for (auto& task : m_tasks)
+        {
+            if (task->error)
+            {
+                if (!error) { error = task->error; }
+                task->sub.Clear();
+            }
+            auto& result = task->sub.GetResult();  // drop trailing comma
+            if (result.size() == 0)
+            {
+                task->sub.Append("null", 4);
+            }
+            extra += task->sub.Size();
+        }
+
+        if (extra > 0)
+        {
+            Splice(extra);
+        }
+        m_tasks.clear();
+        m_builder.EndObject();
+
+        if (error) { std::rethrow_exception(error); }
+    }
+
+private:
+    struct Task
+    {
+        sub_builder sub;
+        size_t offset = 0;  ///< Position in parent right after `"key":`
+        std::future<void> future;
+        std::exception_ptr error;
+    };
+
+    void Splice(size_t extra)
+    {
+        size_t old_size = m_builder.Size();
+        m_builder.Reserve(extra);  // KString does not grow on resize
+        m_builder.json.resize(old_size + extra);
+        char* base = m_builder.json.data();
+
+        // shift: total size of values 0..i while handling value i
+        size_t shift = extra;
+        size_t seg_end = old_size;
+        for (size_t i = m_tasks.size(); i > 0; --i)
+        {
+            Task& task = *m_tasks[i - 1];
+            size_t len = task.sub.Size();
+            size_t seg_begin = task.offset;
+            // move segment after this value to its final place
+            ::memmove(base + seg_begin + shift, base + seg_begin, seg_end - seg_begin);
+            shift -= len;
+            ::memcpy(base + seg_begin + shift, task.sub.json.data(), len);
+            seg_end = seg_begin;
+        }
+    }
+
+    builderT& m_builder;
+    ThreadPool& m_pool;
+    std::vector<std::unique_ptr<Task>> m_tasks;
+    bool m_ended = false;
+};
+
+} // namespace wwjson
+
+#endif // JPARALLEL_HPP__
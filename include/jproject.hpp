@@ -0,0 +1,392 @@
+/**
+ * @file jproject.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Runtime field projection (sparse fieldsets) for described structs
+ *
+ * @details This header provides FieldProjection, a compiled form of a field
+ * path list such as `?fields=id,name,owner.email` for a struct described by
+ * WWJSON_FIELDS. Each level is a 64-bit mask over the struct's fields, plus
+ * nested projections for the fields selected only in part:
+ * ```
+ * id,name,owner.email  ->  {mask: id|name|owner, owner -> {mask: email}}
+ * ```
+ * to_json_projected() then writes only the selected fields, one bit test per
+ * field. Unrequested fields and subtrees are never visited, so no work is
+ * spent on them, unlike building the full JSON and filtering it afterwards.
+ *
+ * Field names are resolved through a perfect hash table built once per type
+ * on first use, so compiling a projection per request is one hash and one
+ * string compare per path segment.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * auto proj = FieldProjection::Compile<User>(request.query("fields"));
+ * std::string json = wwjson::to_json_projected(user, proj);
+ * ```
+ *
+ * @note A path may step into a member that is a described struct, or an
+ * optional, sequence or map of them, where the nested projection applies to
+ * each element. Unknown names and paths into other types are ignored.
+ */
+
+#pragma once
+#ifndef JPROJECT_HPP__
+#define JPROJECT_HPP__
+
+#include "jfields.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace wwjson {
+
+namespace detail {
+
+/// @brief Perfect hash of the field names of one described type
+/// @details FNV-1a with a seed searched so that every name lands in its own
+/// slot of a power-of-two table. Lookup is one hash and one compare.
+struct FieldHash
+{
+    std::vector<std::string_view> names;
+    std::vector<uint8_t> slots;  ///< Field index + 1, or 0 for empty
+    uint32_t seed = 0;
+    uint32_t mask = 0;
+
+    static uint32_t Hash(std::string_view name, uint32_t seed)
+    {
+        uint32_t h = 2166136261u ^ seed;
+        for (char c : name)
+        {
+            h ^= static_cast<uint8_t>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    explicit FieldHash(std::vector<std::string_view>&& fieldNames)
+        : names(std::move(fieldNames))
+    {
+        for (uint32_t size = 8; size <= (1u << 16); size <<= 1)
+        {
+            if (size < names.size() * 2) { continue; }
+            for (uint32_t s = 0; s < 256; ++s)
+            {
+                if (TrySeed(size, s)) { return; }
+            }
+        }
+        slots.clear();  // not found, lookup falls back to linear search
+    }
+
+    /// Field index of `name`, -1 if not a field.
+    int Find(std::string_view name) const
+    {
+        if (wwjson_unlikely(slots.empty()))
+        {
+            for (size_t i = 0; i < names.size(); ++i)
+            {
+                if (names[i] == name) { return static_cast<int>(i); }
+            }
+            return -1;
+        }
+        uint8_t slot = slots[Hash(name, seed) & mask];
+        if (slot == 0 || names[slot - 1] != name) { return -1; }
+        return slot - 1;
+    }
+
+private:
+    bool TrySeed(uint32_t size, uint32_t s)
+    {
+        slots.assign(size, 0);
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            uint8_t& slot = slots[Hash(names[i], s) & (size - 1)];
+            if (slot != 0) { return false; }
+            slot = static_cast<uint8_t>(i + 1);
+        }
+        seed = s;
+        mask = size - 1;
+        return true;
+    }
+};
+
+/// Field name hash of a described type, built on first use.
+template <typename structT>
+const FieldHash& field_hash()
+{
+    static const FieldHash hash = [] {
+        const auto& fields = wwjson_fields(static_cast<const structT*>(nullptr));
+        using fieldsT = std::decay_t<decltype(fields)>;
+        std::vector<std::string_view> names;
+        names.reserve(fieldsT::kCount);
+        for (size_t i = 0; i < fieldsT::kCount; ++i) { names.push_back(fields.name(i)); }
+        return FieldHash(std::move(names));
+    }();
+    return hash;
+}
+
+/// @brief Described type a nested projection applies to, void if none
+/// @details Looks through optionals, sequences and maps to their elements.
+template <typename T, typename = void>
+struct projected_type
+{
+    using type = void;
+};
+
+template <typename T>
+struct projected_type<T, std::enable_if_t<has_fields_v<T>>>
+{
+    using type = T;
+};
+
+template <typename T>
+struct projected_type<std::optional<T>>
+{
+    using type = typename projected_type<T>::type;
+};
+
+template <typename T>
+struct projected_type<T, std::enable_if_t<is_vector_v<T> && !has_fields_v<T>>>
+{
+    using type = typename projected_type<typename T::value_type>::type;
+};
+
+template <typename T>
+struct projected_type<T, std::enable_if_t<is_map_v<T> && !has_fields_v<T>>>
+{
+    using type = typename projected_type<typename T::mapped_type>::type;
+};
+
+template <typename T>
+inline constexpr bool is_projectable_v =
+    !std::is_void_v<typename projected_type<std::decay_t<T>>::type>;
+
+} // namespace detail
+
+/// @brief Compiled field paths selecting part of a described struct
+/// @details Fields are selected whole, or in part with a nested projection
+/// when a path continues into the field (`owner.email`). Selecting a field
+/// whole overrides any partial selection of it. An empty projection selects
+/// nothing and writes `{}`; serialize without projection when the client
+/// asks for no field filter.
+class FieldProjection
+{
+public:
+    FieldProjection() = default;
+
+    /// @brief Compile comma separated field paths for structT
+    /// @param paths Paths like `"id,name,owner.email"`, spaces ignored
+    template <typename structT>
+    static FieldProjection Compile(std::string_view paths)
+    {
+        static_assert(detail::has_fields_v<structT>, "projection needs a WWJSON_FIELDS type");
+        FieldProjection proj;
+        while (!paths.empty())
+        {
+            size_t comma = paths.find(',');
+            proj.AddPath<structT>(Trim(paths.substr(0, comma)));
+            if (comma == std::string_view::npos) { break; }
+            paths.remove_prefix(comma + 1);
+        }
+        return proj;
+    }
+
+    /// Mask of selected fields, bit i for field i.
+    uint64_t mask() const { return m_select; }
+    bool empty() const { return m_select == 0; }
+
+    /// Check if field i is selected, whole or in part.
+    bool Has(size_t i) const { return (m_select >> i) & 1; }
+
+    /// Nested projection of field i, nullptr if selected whole or not at all.
+    const FieldProjection* Sub(size_t i) const
+    {
+        if (!((m_partial >> i) & 1)) { return nullptr; }
+        return &m_sub[Rank(i)];
+    }
+
+private:
+    static std::string_view Trim(std::string_view text)
+    {
+        while (!text.empty() && text.front() == ' ') { text.remove_prefix(1); }
+        while (!text.empty() && text.back() == ' ') { text.remove_suffix(1); }
+        return text;
+    }
+
+    /// Index into m_sub of field i, which are kept in field order.
+    size_t Rank(size_t i) const
+    {
+        uint64_t below = i == 0 ? 0 : (m_partial & (~uint64_t(0) >> (64 - i)));
+        size_t rank = 0;
+        for (; below != 0; below &= below - 1) { ++rank; }
+        return rank;
+    }
+
+    template <typename structT>
+    void AddPath(std::string_view path)
+    {
+        size_t dot = path.find('.');
+        std::string_view name = path.substr(0, dot);
+        int field = detail::field_hash<structT>().Find(name);
+        if (field < 0) { return; }
+        size_t i = static_cast<size_t>(field);
+
+        if (dot == std::string_view::npos)
+        {
+            if ((m_partial >> i) & 1)
+            {
+                m_sub.erase(m_sub.begin() + Rank(i));
+                m_partial &= ~(uint64_t(1) << i);
+            }
+            m_select |= uint64_t(1) << i;
+            return;
+        }
+        if (Has(i) && !((m_partial >> i) & 1)) { return; }  // already whole
+
+        using fieldsT = std::decay_t<decltype(wwjson_fields(static_cast<const structT*>(nullptr)))>;
+        AddNested<structT>(i, path.substr(dot + 1),
+                           std::make_index_sequence<fieldsT::kCount>{});
+    }
+
+    template <typename structT, size_t... Is>
+    void AddNested(size_t i, std::string_view rest, std::index_sequence<Is...>)
+    {
+        using fieldsT = std::decay_t<decltype(wwjson_fields(static_cast<const structT*>(nullptr)))>;
+        using membersT = typename fieldsT::members_type;
+        auto step = [&](auto index) {
+            constexpr size_t I = decltype(index)::value;
+            using memberT = typename detail::member_value<std::tuple_element_t<I, membersT>>::type;
+            using nestedT = typename detail::projected_type<memberT>::type;
+            if constexpr (!std::is_void_v<nestedT>)
+            {
+                if (I != i) { return; }
+                FieldProjection nested;
+                if ((m_partial >> i) & 1) { nested = std::move(m_sub[Rank(i)]); }
+                nested.AddPath<nestedT>(rest);
+                if (nested.empty()) { return; }
+                if ((m_partial >> i) & 1) { m_sub[Rank(i)] = std::move(nested); }
+                else
+                {
+                    m_sub.insert(m_sub.begin() + Rank(i), std::move(nested));
+                    m_partial |= uint64_t(1) << i;
+                    m_select |= uint64_t(1) << i;
+                }
+            }
+        };
+        (step(std::integral_constant<size_t, Is>{}), ...);
+    }
+
+    uint64_t m_select = 0;   ///< Selected fields
+    uint64_t m_partial = 0;  ///< Selected fields with a nested projection
+    std::vector<FieldProjection> m_sub;  ///< Nested projections, in field order
+};
+
+namespace detail {
+
+template <typename builderT, typename structT>
+void write_projected(builderT& builder, const structT& value, const FieldProjection& proj);
+
+/// @brief to_json_impl with a nested projection for the described elements
+template <typename builderT, typename keyT, typename valueT>
+void project_impl(builderT& builder, keyT&& key, const valueT& value, const FieldProjection& proj)
+{
+    constexpr bool has_key = is_key_v<keyT>;
+    if constexpr (is_optional_v<valueT>)
+    {
+        if (value.has_value()) { project_impl(builder, std::forward<keyT>(key), value.value(), proj); }
+        else { to_json_impl(builder, std::forward<keyT>(key), value); }
+    }
+    else if constexpr (has_fields_v<valueT>)
+    {
+        if constexpr (has_key) { builder.AddMember(std::forward<keyT>(key)); }
+        write_projected(builder, value, proj);
+    }
+    else if constexpr (is_map_v<valueT>)
+    {
+        if constexpr (has_key) { builder.AddMember(std::forward<keyT>(key)); }
+        builder.BeginObject();
+        for (const auto& [k, v] : value) { project_impl(builder, k, v, proj); }
+        builder.EndObject();
+    }
+    else if constexpr (is_vector_v<valueT>)
+    {
+        if constexpr (has_key) { builder.AddMember(std::forward<keyT>(key)); }
+        builder.BeginArray();
+        for (const auto& elem : value) { project_impl(builder, NotKey{}, elem, proj); }
+        builder.EndArray();
+    }
+    else
+    {
+        to_json_impl(builder, std::forward<keyT>(key), value);
+    }
+}
+
+template <typename builderT, typename structT, typename fieldsT, size_t... Is>
+void write_projected_each(builderT& builder, const structT& value, const fieldsT& fields,
+                          const FieldProjection& proj, std::index_sequence<Is...>)
+{
+    builder.PutChar('{');
+    bool skip = true;  // the next fragment's leading '{' or ',' is not needed
+    auto step = [&](size_t i, const auto& member) {
+        if (!proj.Has(i)) { return; }
+        std::string_view frag = fields.fragment(i);
+        builder.Append(frag.data() + skip, frag.size() - skip);
+        if constexpr (is_projectable_v<decltype(member)>)
+        {
+            if (const FieldProjection* sub = proj.Sub(i))
+            {
+                project_impl(builder, NotKey{}, member, *sub);
+                skip = true;
+                return;
+            }
+        }
+        skip = put_field_value(builder, member);
+    };
+    (step(Is, value.*std::get<Is>(fields.members)), ...);
+    builder.EndObject();
+}
+
+/// @brief Serialize the selected fields of a described struct as `{...},`
+template <typename builderT, typename structT>
+void write_projected(builderT& builder, const structT& value, const FieldProjection& proj)
+{
+    const auto& fields = wwjson_fields(static_cast<const structT*>(nullptr));
+    using fieldsT = std::decay_t<decltype(fields)>;
+    write_projected_each(builder, value, fields, proj, std::make_index_sequence<fieldsT::kCount>{});
+}
+
+} // namespace detail
+
+/// @brief Serialize the projected fields of a value to a builder
+/// @param value Described struct, or optional, sequence or map of them
+template <typename builderT, typename valueT>
+void to_json_projected(builderT& builder, const valueT& value, const FieldProjection& proj)
+{
+    static_assert(detail::is_projectable_v<valueT>, "projection needs a WWJSON_FIELDS type");
+    detail::project_impl(builder, detail::NotKey{}, value, proj);
+}
+
+/// @brief Serialize the projected fields of a value as a member `key`
+template <typename builderT, typename valueT>
+void to_json_projected(builderT& builder, const char* key, const valueT& value,
+                       const FieldProjection& proj)
+{
+    static_assert(detail::is_projectable_v<valueT>, "projection needs a WWJSON_FIELDS type");
+    detail::project_impl(builder, key, value, proj);
+}
+
+/// @brief Serialize the projected fields of a value to a new string
+/// @tparam resultT std::string (default), JString or ReleasedBuffer
+template <typename resultT = std::string, typename valueT>
+resultT to_json_projected(const valueT& value, const FieldProjection& proj)
+{
+    Builder builder;
+    to_json_projected(builder, value, proj);
+    return detail::move_result<resultT>(builder);
+}
+
+} // namespace wwjson
+
+#endif // JPROJECT_HPP__
@@ -0,0 +1,287 @@
+/**
+ * @file jpull.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Pull-based incremental JSON serialization in bounded chunks
+ *
+ * @details This header provides PullSerializer, which walks a value by the
+ * same rules as wwjson::to_json and produces its JSON only when the caller
+ * asks for the next chunk: Read(buffer, size) fills at most `size` bytes.
+ * It suits streaming a large result to a slow client from an event loop,
+ * serializing more only when the socket drains.
+ *
+ * Containers (sequence and map) are walked one element at a time with an
+ * explicit frame stack, nested containers included. Scalars and structs
+ * with a to_json(builder) method are written as a whole, so peak memory is
+ * about one chunk plus the largest such element, independent of the total
+ * output size.
+ *
+ * With C++20 coroutines, to_json_chunks() wraps the same state machine in a
+ * generator yielding std::string_view chunks of the caller's buffer.
+ */
+
+#pragma once
+#ifndef JPULL_HPP__
+#define JPULL_HPP__
+
+#include "jbuilder.hpp"
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define WWJSON_HAS_COROUTINE 1
+#include <coroutine>
+#include <exception>
+#else
+#define WWJSON_HAS_COROUTINE 0
+#endif
+
+namespace wwjson {
+
+/// @brief Resumable serializer producing JSON in caller-sized chunks
+/// @details
+/// The serialized value is referenced, not copied: it must stay alive and
+/// unchanged until the serializer is done.
+///
+/// @par Usage Example:
+/// ```cpp
+/// PullSerializer puller(rows);
+/// char chunk[16 * 1024];
+/// // whenever the socket is writable:
+/// size_t n = puller.Read(chunk, sizeof(chunk));
+/// if (n == 0) { /* finished */ }
+/// ```
+class PullSerializer
+{
+    /// One container being walked.
+    struct Frame
+    {
+        virtual ~Frame() = default;
+        /// Write the next element or the closing bracket, false when closed.
+        virtual bool Next(PullSerializer& puller) = 0;
+    };
+
+    template <typename containerT>
+    struct ContainerFrame : public Frame
+    {
+        using iterator = decltype(std::declval<const containerT&>().begin());
+        iterator it;
+        iterator end;
+
+        explicit ContainerFrame(const containerT& container)
+            : it(container.begin()), end(container.end())
+        {
+        }
+
+        bool Next(PullSerializer& puller) override
+        {
+            constexpr bool is_map = detail::is_map_v<containerT>;
+            if (it == end)
+            {
+                if constexpr (is_map) { puller.m_builder.EndObject(); }
+                else { puller.m_builder.EndArray(); }
+                return false;
+            }
+            const auto& elem = *it;
+            ++it;
+            if constexpr (is_map) { puller.Push(elem.first, elem.second); }
+            else { puller.Push(detail::NotKey{}, elem); }
+            return true;
+        }
+    };
+
+public:
+    /// @brief Prepare to serialize `value` like `wwjson::to_json(builder, value)`
+    /// @param capacity Initial size of the internal buffer
+    template <typename valueT>
+    explicit PullSerializer(const valueT& value, size_t capacity = 1024)
+        : m_builder(capacity)
+    {
+        Push(detail::NotKey{}, value);
+    }
+
+    PullSerializer(const PullSerializer&) = delete;
+    PullSerializer& operator=(const PullSerializer&) = delete;
+
+    /// @brief Write the next at most `size` bytes to `dst`
+    /// @return Bytes written, 0 once the whole document has been read
+    size_t Read(char* dst, size_t size)
+    {
+        while (Available() < size && !m_finished) { Step(); }
+        size_t n = Available();
+        if (n > size) { n = size; }
+        JString& json = m_builder.json;
+        ::memcpy(dst, json.data() + m_read, n);
+        m_read += n;
+
+        // keep only the unread tail, at most about one element
+        size_t rest = json.size() - m_read;
+        if (rest > 0) { ::memmove(json.data(), json.data() + m_read, rest); }
+        json.resize(rest);
+        m_read = 0;
+        return n;
+    }
+
+    /// True when all output has been read.
+    bool done() const { return m_finished && m_builder.json.empty(); }
+
+    /// Current capacity of the internal buffer, for memory checks.
+    size_t capacity() const { return m_builder.json.capacity(); }
+
+private:
+    /// Write a value, or open a frame for a container to walk later.
+    template <typename keyT, typename valueT>
+    void Push(keyT&& key, const valueT& value)
+    {
+        constexpr bool has_key = detail::is_key_v<std::decay_t<keyT>>;
+        if constexpr (detail::is_optional_v<valueT>)
+        {
+            if (value.has_value()) { Push(std::forward<keyT>(key), value.value()); }
+            else { detail::to_json_impl(m_builder, std::forward<keyT>(key), value); }
+        }
+        else if constexpr (detail::is_map_v<valueT> || detail::is_vector_v<valueT>)
+        {
+            if constexpr (has_key) { m_builder.AddMember(std::forward<keyT>(key)); }
+            if constexpr (detail::is_map_v<valueT>) { m_builder.BeginObject(); }
+            else { m_builder.BeginArray(); }
+            m_stack.push_back(std::make_unique<ContainerFrame<valueT>>(value));
+        }
+        else
+        {
+            detail::to_json_impl(m_builder, std::forward<keyT>(key), value);
+        }
+    }
+
+    /// Advance the innermost container by one element.
+    void Step()
+    {
+        if (m_stack.empty())
+        {
+            m_builder.GetResult();  // drop the trailing comma
+            m_finished = true;
+            return;
+        }
+        size_t top = m_stack.size() - 1;
+        if (!m_stack[top]->Next(*this))
+        {
+            m_stack.erase(m_stack.begin() + top);
+        }
+    }
+
+    /// Bytes ready to read, holding back a trailing comma that a closing
+    /// bracket may still replace.
+    size_t Available() const
+    {
+        const JString& json = m_builder.json;
+        size_t n = json.size() - m_read;
+        if (!m_finished && n > 0 && json.back() == ',') { --n; }
+        return n;
+    }
+
+    Builder m_builder;
+    std::vector<std::unique_ptr<Frame>> m_stack;
+    size_t m_read = 0;
+    bool m_finished = false;
+};
+
+#if WWJSON_HAS_COROUTINE
+/// @brief Generator of JSON chunks, the C++20 coroutine form of PullSerializer
+/// @details Resuming the generator serializes just enough for the next chunk.
+/// Each yielded view points into the caller's buffer and is valid until the
+/// next resumption.
+class ChunkGenerator
+{
+public:
+    struct promise_type
+    {
+        std::string_view current;
+
+        ChunkGenerator get_return_object()
+        {
+            return ChunkGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(std::string_view chunk) noexcept
+        {
+            current = chunk;
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { throw; }
+    };
+
+    /// Input iterator for range-for over the chunks.
+    class iterator
+    {
+    public:
+        explicit iterator(ChunkGenerator* owner) : m_owner(owner) {}
+        std::string_view operator*() const { return m_owner->value(); }
+        iterator& operator++()
+        {
+            if (!m_owner->next()) { m_owner = nullptr; }
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return m_owner == other.m_owner; }
+        bool operator!=(const iterator& other) const { return m_owner != other.m_owner; }
+
+    private:
+        ChunkGenerator* m_owner;
+    };
+
+    ChunkGenerator(ChunkGenerator&& other) noexcept : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+    ChunkGenerator(const ChunkGenerator&) = delete;
+    ChunkGenerator& operator=(const ChunkGenerator&) = delete;
+
+    ~ChunkGenerator()
+    {
+        if (m_handle) { m_handle.destroy(); }
+    }
+
+    /// Produce the next chunk, false when finished.
+    bool next()
+    {
+        if (!m_handle || m_handle.done()) { return false; }
+        m_handle.resume();
+        return !m_handle.done();
+    }
+
+    /// Chunk produced by the last successful next().
+    std::string_view value() const { return m_handle.promise().current; }
+
+    iterator begin() { return iterator(next() ? this : nullptr); }
+    iterator end() { return iterator(nullptr); }
+
+private:
+    explicit ChunkGenerator(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+/// @brief Serialize `value` lazily in chunks of at most `size` bytes of `buffer`
+/// @code
+/// char buffer[4096];
+/// for (std::string_view chunk : wwjson::to_json_chunks(rows, buffer, sizeof(buffer))) {
+///     co_await socket.write(chunk);
+/// }
+/// @endcode
+template <typename valueT>
+ChunkGenerator to_json_chunks(const valueT& value, char* buffer, size_t size)
+{
+    PullSerializer puller(value);
+    while (size_t n = puller.Read(buffer, size))
+    {
+        co_yield std::string_view(buffer, n);
+    }
+}
+#endif // WWJSON_HAS_COROUTINE
+
+} // namespace wwjson
+
+#endif // JPULL_HPP__
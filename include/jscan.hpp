@@ -0,0 +1,280 @@
+/**
+ * @file jscan.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief On-demand scanner returning raw subtrees of a JSON text
+ *
+ * @details When proxying an upstream JSON response, forwarding a few of its
+ * subtrees only needs their byte ranges, not a DOM of the whole document.
+ * scan_path() walks a JSON Pointer (RFC 6901) through the text and returns a
+ * string_view of the value found, skipping every other value structurally:
+ * strings are crossed eight bytes at a time looking only for `"` and `\`,
+ * containers by counting brackets, and nothing is decoded or allocated.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * std::string_view items = wwjson::scan_path(upstream, "/data/items");
+ * if (!items.empty())
+ * {
+ *     builder.AddMemberSub("items", items);
+ * }
+ * ```
+ *
+ * @note The scanner trusts its input to be well-formed JSON, as from an
+ * upstream service; it does not validate the values it skips. Malformed or
+ * truncated input yields an empty view and never reads out of the buffer.
+ * Object keys are compared in their raw form, so a key written with escapes
+ * only matches a token with the same escapes.
+ */
+
+#pragma once
+#ifndef JSCAN_HPP__
+#define JSCAN_HPP__
+
+#include "wwjson.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace wwjson {
+
+namespace detail {
+
+inline const char* scan_ws(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) { ++p; }
+    return p;
+}
+
+/// High bit mask of the bytes `"` or `\`, the lowest one exact.
+inline uint64_t quote_escape_mask(uint64_t word)
+{
+    constexpr uint64_t kOnes = 0x0101010101010101ULL;
+    constexpr uint64_t kHighs = 0x8080808080808080ULL;
+    uint64_t quote = word ^ (kOnes * '"');
+    uint64_t escape = word ^ (kOnes * '\\');
+    return (((quote - kOnes) & ~quote) | ((escape - kOnes) & ~escape)) & kHighs;
+}
+
+/// @brief Skip a string body
+/// @param p Just after the opening quote
+/// @return Just after the closing quote, nullptr if unterminated
+inline const char* scan_string(const char* p, const char* end)
+{
+    for (;;)
+    {
+        while (end - p >= 8)
+        {
+            uint64_t word;
+            ::memcpy(&word, p, 8);
+            uint64_t mask = quote_escape_mask(word);
+            if (mask != 0)
+            {
+                p += first_flagged_byte(mask);
+                break;
+            }
+            p += 8;
+        }
+        if (wwjson_unlikely(p >= end)) { return nullptr; }
+        if (*p == '"') { return p + 1; }
+        if (*p == '\\') { p += 2; }
+        else { ++p; }
+    }
+}
+
+/// @brief Skip an object or array by counting brackets
+/// @param p At the opening bracket
+inline const char* scan_container(const char* p, const char* end)
+{
+    size_t depth = 0;
+    while (p < end)
+    {
+        switch (*p)
+        {
+        case '"':
+            p = scan_string(p + 1, end);
+            if (wwjson_unlikely(p == nullptr)) { return nullptr; }
+            continue;
+        case '{':
+        case '[':
+            ++depth;
+            break;
+        case '}':
+        case ']':
+            if (--depth == 0) { return p + 1; }
+            break;
+        default:
+            break;
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+/// @brief Skip one value
+/// @param p At the first byte of the value
+/// @return Just after the value, nullptr if malformed
+inline const char* scan_value(const char* p, const char* end)
+{
+    if (wwjson_unlikely(p >= end)) { return nullptr; }
+    switch (*p)
+    {
+    case '"':
+        return scan_string(p + 1, end);
+    case '{':
+    case '[':
+        return scan_container(p, end);
+    case ',':
+    case ':':
+    case '}':
+    case ']':
+        return nullptr;
+    default:
+        break;
+    }
+    // number, true, false, null
+    const char* q = p;
+    while (q < end && *q != ',' && *q != '}' && *q != ']' && *q != ' ' && *q != '\n'
+           && *q != '\r' && *q != '\t')
+    {
+        ++q;
+    }
+    return q;
+}
+
+inline std::string_view scan_range(const char* begin, const char* end)
+{
+    return std::string_view(begin, static_cast<size_t>(end - begin));
+}
+
+} // namespace detail
+
+/// @brief Find a member of an object
+/// @param json Text starting with the object, trailing text is ignored
+/// @param key Raw key, as written between the quotes
+/// @return Raw text of the member value, empty if not found
+inline std::string_view scan_member(std::string_view json, std::string_view key)
+{
+    const char* end = json.data() + json.size();
+    const char* p = detail::scan_ws(json.data(), end);
+    if (p >= end || *p != '{') { return {}; }
+    p = detail::scan_ws(p + 1, end);
+    if (p < end && *p == '}') { return {}; }
+    while (p < end && *p == '"')
+    {
+        const char* name = p + 1;
+        p = detail::scan_string(name, end);
+        if (wwjson_unlikely(p == nullptr)) { return {}; }
+        std::string_view raw = detail::scan_range(name, p - 1);
+        p = detail::scan_ws(p, end);
+        if (p >= end || *p != ':') { return {}; }
+        const char* value = detail::scan_ws(p + 1, end);
+        p = detail::scan_value(value, end);
+        if (wwjson_unlikely(p == nullptr)) { return {}; }
+        if (raw == key) { return detail::scan_range(value, p); }
+        p = detail::scan_ws(p, end);
+        if (p >= end || *p != ',') { return {}; }
+        p = detail::scan_ws(p + 1, end);
+    }
+    return {};
+}
+
+/// @brief Find an item of an array
+/// @param json Text starting with the array, trailing text is ignored
+/// @return Raw text of the item, empty if out of range
+inline std::string_view scan_item(std::string_view json, size_t index)
+{
+    const char* end = json.data() + json.size();
+    const char* p = detail::scan_ws(json.data(), end);
+    if (p >= end || *p != '[') { return {}; }
+    p = detail::scan_ws(p + 1, end);
+    if (p < end && *p == ']') { return {}; }
+    for (size_t i = 0; p < end; ++i)
+    {
+        const char* value = p;
+        p = detail::scan_value(value, end);
+        if (wwjson_unlikely(p == nullptr)) { return {}; }
+        if (i == index) { return detail::scan_range(value, p); }
+        p = detail::scan_ws(p, end);
+        if (p >= end || *p != ',') { return {}; }
+        p = detail::scan_ws(p + 1, end);
+    }
+    return {};
+}
+
+/// @brief Find a value by JSON Pointer
+/// @param json A JSON text
+/// @param path JSON Pointer such as "/data/items/0", "" for the whole text;
+/// `~1` and `~0` in a token stand for `/` and `~`
+/// @return Raw text of the value without surrounding spaces, empty if not
+/// found
+inline std::string_view scan_path(std::string_view json, std::string_view path)
+{
+    const char* end = json.data() + json.size();
+    const char* p = detail::scan_ws(json.data(), end);
+    if (path.empty())
+    {
+        const char* value_end = detail::scan_value(p, end);
+        if (value_end == nullptr) { return {}; }
+        return detail::scan_range(p, value_end);
+    }
+
+    // the root view runs to the end of the text, found values are exact
+    std::string_view current = detail::scan_range(p, end);
+    std::string unescaped;
+    while (!path.empty())
+    {
+        if (path[0] != '/') { return {}; }
+        size_t slash = path.find('/', 1);
+        std::string_view token = path.substr(1, slash == std::string_view::npos ? slash : slash - 1);
+        path.remove_prefix(slash == std::string_view::npos ? path.size() : slash);
+        if (wwjson_unlikely(token.find('~') != std::string_view::npos))
+        {
+            unescaped.clear();
+            for (size_t i = 0; i < token.size(); ++i)
+            {
+                if (token[i] == '~' && i + 1 < token.size())
+                {
+                    ++i;
+                    unescaped.push_back(token[i] == '1' ? '/' : '~');
+                }
+                else
+                {
+                    unescaped.push_back(token[i]);
+                }
+            }
+            token = unescaped;
+        }
+
+        if (current.empty()) { return {}; }
+        if (current[0] == '{')
+        {
+            current = scan_member(current, token);
+        }
+        else if (current[0] == '[')
+        {
+            if (token.empty()) { return {}; }
+            size_t index = 0;
+            for (char c : token)
+            {
+                if (c < '0' || c > '9') { return {}; }
+                index = index * 10 + static_cast<size_t>(c - '0');
+            }
+            current = scan_item(current, index);
+        }
+        else
+        {
+            return {};
+        }
+        if (current.empty()) { return {}; }
+    }
+    return current;
+}
+
+} // namespace wwjson
+
+#endif // JSCAN_HPP__
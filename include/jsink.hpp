@@ -0,0 +1,352 @@
+/**
+ * @file jsink.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Streaming JSON builder that flushes output to a sink as it goes
+ *
+ * @details This header provides FlushBuffer, a string buffer for GenericBuilder
+ * that holds only a bounded window of the document. Whenever the buffer would
+ * grow beyond its high-water mark, the completed bytes are written to a sink
+ * (file descriptor, FILE* or user callback) and only a small tail is kept,
+ * so that builder operations looking back at the last character (FixTail,
+ * Back, GetResult) still work.
+ *
+ * @par Type Aliases:
+ * - **FlushString**: FlushBuffer<4> - same unsafe level as JString
+ * - **FlushBuilder**: GenericBuilder<FlushString> - bounded-memory streaming builder
+ */
+
+#pragma once
+#ifndef JSINK_HPP__
+#define JSINK_HPP__
+
+#include "jbuilder.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace wwjson {
+
+/// @brief Destination for flushed bytes: return false on write failure
+using FlushSink = std::function<bool(const char*, size_t)>;
+
+/// @brief Sink that writes to a C stdio stream (not closed by the sink)
+inline FlushSink FileSink(FILE* fp)
+{
+    return [fp](const char* data, size_t len) -> bool {
+        return fp != nullptr && std::fwrite(data, 1, len, fp) == len;
+    };
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+/// @brief Sink that writes to a POSIX file descriptor (not closed by the sink)
+/// @details Retries on partial write and EINTR.
+inline FlushSink FdSink(int fd)
+{
+    return [fd](const char* data, size_t len) -> bool {
+        while (len > 0)
+        {
+            ssize_t n = ::write(fd, data, len);
+            if (n < 0)
+            {
+                if (errno == EINTR) { continue; }
+                return false;
+            }
+            data += n;
+            len -= static_cast<size_t>(n);
+        }
+        return true;
+    };
+}
+#endif
+
+/// @brief Bounded string buffer that flushes completed bytes to a sink
+/// @tparam LEVEL Number of additional bytes that can be written unsafely after a safe check
+/// @details
+/// FlushBuffer owns a fixed heap window of `high_water` bytes. When a write
+/// (through reserve_ex) would exceed the window, all but the last `keep` bytes
+/// are passed to the sink and the tail is moved to the front of the window.
+/// Peak memory therefore stays around the high-water mark regardless of the
+/// document size; the window only grows when a single write is larger
+/// than itself.
+///
+/// @par Flush Protocol:
+/// - flush(): write completed bytes now, still keeping the tail
+/// - finish(): write everything left and clear the buffer, call it after
+///   the final EndObject/EndArray (via GetResult to drop a trailing comma)
+/// - The destructor calls finish(), like std::ofstream
+///
+/// @par Error Handling:
+/// When the sink reports failure, failed() becomes true and later output is
+/// discarded (still in bounded memory); the builder itself keeps working.
+///
+/// @par Usage Example:
+/// ```cpp
+/// FlushBuilder builder(FlushString(FileSink(stdout), 64 * 1024), 0);
+/// builder.BeginArray();
+/// for (auto& row : rows) { builder.AddItem(row); }
+/// builder.EndArray();
+/// bool ok = builder.GetResult().finish();
+/// ```
+///
+/// @note Only the retained window is visible through data()/size(), so
+/// methods that re-read the whole result (e.g. Merge, str()) see the tail only.
+template <UnsafeLevel LEVEL>
+class FlushBuffer : public BufferView
+{
+public:
+    static constexpr uint8_t kUnsafeLevel = LEVEL;
+    static constexpr size_t kDefaultHighWater = 64 * 1024;
+    static constexpr size_t kDefaultKeep = 16;
+
+protected:
+    FlushSink m_sink;              ///< Destination of flushed bytes
+    size_t m_keep = kDefaultKeep;  ///< Bytes retained at tail after flush
+    size_t m_flushed = 0;          ///< Total bytes already passed to sink
+    bool m_failed = false;         ///< Whether the sink has reported failure
+
+public:
+    using BufferView::reserve_ex;
+
+    /// @{ M0: Constructors and assignment operators
+
+    /// Default constructor - no sink and no window, the first reserve allocates.
+    FlushBuffer() = default;
+
+    /// @brief Create buffer flushing to sink
+    /// @param sink Destination of flushed bytes (may be empty to discard)
+    /// @param high_water Window size that triggers a flush when crossed
+    /// @param keep Tail bytes kept after flush, at least 1 for FixTail
+    explicit FlushBuffer(FlushSink sink, size_t high_water = kDefaultHighWater,
+                         size_t keep = kDefaultKeep)
+        : m_sink(std::move(sink)), m_keep(keep > 0 ? keep : 1)
+    {
+        if (high_water < m_keep * 2) { high_water = m_keep * 2; }
+        allocate(high_water + kUnsafeLevel + 1);
+    }
+
+    /// Copy constructor is deleted (owns sink state)
+    FlushBuffer(const FlushBuffer&) = delete;
+
+    /// Move constructor - transfer window and sink
+    FlushBuffer(FlushBuffer&& other) noexcept
+        : BufferView(std::move(other)), m_sink(std::move(other.m_sink)),
+          m_keep(other.m_keep), m_flushed(other.m_flushed), m_failed(other.m_failed)
+    {
+        other.m_sink = nullptr;
+        other.m_flushed = 0;
+    }
+
+    /// Copy assignment is deleted (owns sink state)
+    FlushBuffer& operator=(const FlushBuffer&) = delete;
+
+    /// Move assignment - finish current output then transfer
+    FlushBuffer& operator=(FlushBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            finish();
+            deallocate();
+            BufferView::operator=(std::move(other));
+            m_sink = std::move(other.m_sink);
+            m_keep = other.m_keep;
+            m_flushed = other.m_flushed;
+            m_failed = other.m_failed;
+            other.m_sink = nullptr;
+            other.m_flushed = 0;
+        }
+        return *this;
+    }
+
+    ~FlushBuffer()
+    {
+        finish();
+        deallocate();
+    }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M1: Flush control and state
+
+    /// Write completed bytes to sink, keeping the tail for look-back.
+    void flush()
+    {
+        size_t len = size();
+        if (len <= m_keep) { return; }
+        size_t out = len - m_keep;
+        output(m_begin, out);
+        ::memmove(m_begin, m_begin + out, m_keep);
+        m_end = m_begin + m_keep;
+    }
+
+    /// Write all remaining bytes to sink and clear buffer.
+    /// @return true if all output so far reached the sink
+    bool finish()
+    {
+        if (!empty())
+        {
+            output(m_begin, size());
+            m_end = m_begin;
+        }
+        return !m_failed;
+    }
+
+    /// Total bytes already passed to sink (excluding retained window).
+    size_t flushed() const { return m_flushed; }
+
+    /// Total bytes of the document written so far.
+    size_t total_size() const { return m_flushed + size(); }
+
+    /// Whether the sink has reported a write failure.
+    bool failed() const { return m_failed; }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M2: Capacity management
+
+    /// Ensure `add_capacity + kUnsafeLevel` writable bytes, flushing first.
+    bool reserve_ex(size_t add_capacity)
+    {
+        if (wwjson_likely(size() + add_capacity + kUnsafeLevel <= capacity()))
+        {
+            return true;
+        }
+        flush();
+        size_t need = size() + add_capacity + kUnsafeLevel;
+        if (need > capacity())
+        {
+            try
+            {
+                allocate(need + 1);
+            }
+            catch (const std::bad_alloc&)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Reserve relative to current size, as the window may be flushed.
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > size())
+        {
+            reserve_ex(new_capacity - size());
+        }
+    }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M3: Write operations that flush when needed
+
+    void append(const char* str)
+    {
+        if (str == nullptr) { return; }
+        append(str, ::strlen(str));
+    }
+
+    void append(const char* str, size_t len)
+    {
+        reserve_ex(len);
+        unsafe_append(str, len);
+    }
+
+    void append(const std::string& str)
+    {
+        append(str.data(), str.size());
+    }
+
+    void append(const std::string_view& sv)
+    {
+        append(sv.data(), sv.size());
+    }
+
+    void append(const BufferView& other)
+    {
+        append(other.data(), other.size());
+    }
+
+    void push_back(char c)
+    {
+        reserve_ex(1);
+        unsafe_push_back(c);
+    }
+
+    void append(size_t count, char ch)
+    {
+        reserve_ex(count);
+        unsafe_fill(ch, count);
+    }
+
+    /// @}
+
+private:
+    void output(const char* data, size_t len)
+    {
+        if (!m_failed && m_sink)
+        {
+            m_failed = !m_sink(data, len);
+        }
+        m_flushed += len;
+    }
+
+    /// Allocate or grow the window to `alloc_size` bytes (including '\0').
+    void allocate(size_t alloc_size)
+    {
+        size_t current_size = size();
+        char* new_begin = static_cast<char*>(std::realloc(m_begin, alloc_size));
+        if (new_begin == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        m_begin = new_begin;
+        m_end = m_begin + current_size;
+        m_cap_end = m_begin + alloc_size - 1;
+        *m_cap_end = '\0';
+    }
+
+    void deallocate()
+    {
+        if (m_begin)
+        {
+            std::free(m_begin);
+        }
+        m_begin = nullptr;
+        m_end = nullptr;
+        m_cap_end = nullptr;
+    }
+};
+
+/// @brief Flush buffer with the same unsafe level as JString
+using FlushString = FlushBuffer<4>;
+
+/// @brief Builder streaming to a sink with bounded memory
+/// @details
+/// Use for large exports that should not be held in memory entirely.
+/// Pass capacity 0 to the prefix constructor to keep the window size
+/// chosen in FlushString.
+///
+/// @par Example:
+/// @code
+/// FILE* fp = fopen("export.json", "w");
+/// FlushBuilder builder(FlushString(FileSink(fp)), 0);
+/// builder.BeginArray();
+/// builder.AddItem(1);
+/// builder.EndArray();
+/// builder.GetResult().finish();
+/// fclose(fp);
+/// @endcode
+using FlushBuilder = GenericBuilder<FlushString, UnsafeConfig<FlushString>>;
+
+} // namespace wwjson
+
+#endif // JSINK_HPP__
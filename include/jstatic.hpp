@@ -0,0 +1,308 @@
+/**
+ * @file jstatic.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Compile-time JSON of fully static data
+ *
+ * @details This header serializes `constexpr` data, such as lookup tables
+ * and config defaults, into a `std::array<char, N>` during compilation,
+ * with N computed from the data. The JSON is then a literal in read-only
+ * data, with no serialization at startup or reload, and can be embedded in
+ * a runtime document by AddMemberSub/AddItemSub at the cost of one copy:
+ * ```cpp
+ * struct Country
+ * {
+ *     const char* code;
+ *     const char* name;
+ *     int dial;
+ *     constexpr auto to_static_json() const
+ *     {
+ *         return wwjson::static_object(wwjson::static_member("code", code),
+ *             wwjson::static_member("name", name), wwjson::static_member("dial", dial));
+ *     }
+ * };
+ * constexpr Country kCountries[] = {{"CN", "China", 86}, {"FR", "France", 33}};
+ * constexpr auto kCountriesJson = WWJSON_STATIC(kCountries);
+ * builder.AddMemberSub("countries", kCountriesJson.view());
+ * ```
+ *
+ * Supported values: bool, integers, nullptr, strings (`const char*`, char
+ * arrays and std::string_view), std::array and built-in arrays of supported
+ * values, static_object() of static_member(), and structs with a constexpr
+ * to_static_json() method returning one. Strings are always escaped with
+ * the table of BasicConfig.
+ *
+ * @note Floating-point numbers are not supported, their shortest text is not
+ * computable at compile time in C++17; store them as scaled integers or
+ * preformatted strings.
+ */
+
+#pragma once
+#ifndef JSTATIC_HPP__
+#define JSTATIC_HPP__
+
+#include "wwjson.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace wwjson {
+
+/// @brief Key and value of a static object member
+template <typename valueT>
+struct StaticMember
+{
+    std::string_view key;
+    valueT value;
+};
+
+/// @brief Static object, an ordered list of StaticMember
+template <typename... memberTs>
+struct StaticObject
+{
+    std::tuple<memberTs...> members;
+};
+
+/// Make a member of a static object, string literals are kept as `const char*`.
+template <typename valueT>
+constexpr StaticMember<std::decay_t<const valueT>> static_member(std::string_view key, const valueT& value)
+{
+    return StaticMember<std::decay_t<const valueT>>{key, value};
+}
+
+/// Make a static object from static members, written in the given order.
+template <typename... memberTs>
+constexpr StaticObject<memberTs...> static_object(const memberTs&... members)
+{
+    return StaticObject<memberTs...>{std::tuple<memberTs...>(members...)};
+}
+
+/// @brief JSON text computed at compile time, nul-terminated
+/// @tparam N Length of the JSON text
+template <size_t N>
+struct StaticJson
+{
+    std::array<char, N + 1> text{};
+
+    constexpr size_t size() const { return N; }
+    constexpr const char* data() const { return text.data(); }
+    constexpr const char* c_str() const { return text.data(); }
+    constexpr std::string_view view() const { return std::string_view(text.data(), N); }
+    constexpr operator std::string_view() const { return view(); }
+    std::string str() const { return std::string(text.data(), N); }
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct has_static_json : std::false_type {};
+
+template <typename T>
+struct has_static_json<T, std::void_t<decltype(std::declval<const T&>().to_static_json())>>
+    : std::true_type {};
+
+template <typename T>
+struct is_static_object : std::false_type {};
+
+template <typename... memberTs>
+struct is_static_object<StaticObject<memberTs...>> : std::true_type {};
+
+template <typename T>
+struct is_std_array : std::false_type {};
+
+template <typename T, size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+/// Output that only counts, for the size pass.
+struct StaticCounter
+{
+    size_t pos = 0;
+    constexpr void put(char) { ++pos; }
+};
+
+/// Output into the fixed array of a StaticJson.
+template <size_t N>
+struct StaticWriter
+{
+    StaticJson<N> json;
+    size_t pos = 0;
+    constexpr void put(char c) { json.text[pos++] = c; }
+};
+
+template <typename writerT>
+constexpr void static_put_string(writerT& out, std::string_view str)
+{
+    constexpr auto& table = BasicConfig<std::string>::kEscapeTable;
+    out.put('"');
+    for (char ch : str)
+    {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (c < 128 && table[c] != 0)
+        {
+            out.put('\\');
+            out.put(static_cast<char>(table[c]));
+        }
+        else
+        {
+            out.put(ch);
+        }
+    }
+    out.put('"');
+}
+
+template <typename writerT, typename intT>
+constexpr void static_put_integer(writerT& out, intT value)
+{
+    using unsignedT = std::make_unsigned_t<intT>;
+    unsignedT mag = static_cast<unsignedT>(value);
+    if constexpr (std::is_signed_v<intT>)
+    {
+        if (value < 0)
+        {
+            out.put('-');
+            mag = static_cast<unsignedT>(unsignedT(0) - mag);
+        }
+    }
+    char digits[24] = {};
+    size_t n = 0;
+    do
+    {
+        digits[n++] = static_cast<char>('0' + mag % 10);
+        mag /= 10;
+    } while (mag != 0);
+    while (n > 0) { out.put(digits[--n]); }
+}
+
+template <typename writerT>
+constexpr void static_put_literal(writerT& out, std::string_view text)
+{
+    for (char c : text) { out.put(c); }
+}
+
+template <typename writerT, typename valueT>
+constexpr void static_put(writerT& out, const valueT& value);
+
+template <typename writerT, typename valueT>
+constexpr void static_put_array(writerT& out, const valueT* items, size_t count)
+{
+    out.put('[');
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0) { out.put(','); }
+        static_put(out, items[i]);
+    }
+    out.put(']');
+}
+
+/// @brief Write one static value, the same code for counting and writing
+template <typename writerT, typename valueT>
+constexpr void static_put(writerT& out, const valueT& value)
+{
+    if constexpr (std::is_same_v<valueT, bool>)
+    {
+        static_put_literal(out, value ? "true" : "false");
+    }
+    else if constexpr (std::is_integral_v<valueT>)
+    {
+        static_put_integer(out, value);
+    }
+    else if constexpr (std::is_floating_point_v<valueT>)
+    {
+        static_assert(!std::is_floating_point_v<valueT>,
+            "floating-point static JSON is not supported, use integers or strings");
+    }
+    else if constexpr (std::is_same_v<valueT, std::nullptr_t>)
+    {
+        static_put_literal(out, "null");
+    }
+    else if constexpr (std::is_same_v<valueT, const char*> || std::is_same_v<valueT, char*>)
+    {
+        if (value == nullptr) { static_put_literal(out, "null"); }
+        else { static_put_string(out, std::string_view(value)); }
+    }
+    else if constexpr (std::is_same_v<valueT, std::string_view>)
+    {
+        static_put_string(out, value);
+    }
+    else if constexpr (std::is_array_v<valueT> && std::is_same_v<std::remove_extent_t<valueT>, char>)
+    {
+        size_t len = 0;
+        while (len < std::extent_v<valueT> && value[len] != '\0') { ++len; }
+        static_put_string(out, std::string_view(value, len));
+    }
+    else if constexpr (std::is_array_v<valueT>)
+    {
+        static_put_array(out, value, std::extent_v<valueT>);
+    }
+    else if constexpr (is_std_array<valueT>::value)
+    {
+        static_put_array(out, value.data(), value.size());
+    }
+    else if constexpr (is_static_object<valueT>::value)
+    {
+        out.put('{');
+        if constexpr (std::tuple_size_v<decltype(value.members)> > 0)
+        {
+            bool first = true;
+            std::apply([&](const auto&... member) {
+                auto put_member = [&](const auto& m) {
+                    if (!first) { out.put(','); }
+                    first = false;
+                    static_put_string(out, m.key);
+                    out.put(':');
+                    static_put(out, m.value);
+                };
+                (put_member(member), ...);
+            }, value.members);
+        }
+        out.put('}');
+    }
+    else
+    {
+        static_assert(has_static_json<valueT>::value,
+            "static JSON value must be bool, integer, string, array, static_object "
+            "or a struct with constexpr to_static_json()");
+        static_put(out, value.to_static_json());
+    }
+}
+
+} // namespace detail
+
+/// Length of the compile-time JSON of a constexpr value.
+template <typename valueT>
+constexpr size_t static_json_size(const valueT& value)
+{
+    detail::StaticCounter counter;
+    detail::static_put(counter, value);
+    return counter.pos;
+}
+
+/// @brief Serialize a constexpr value into a StaticJson<N> at compile time
+/// @tparam N Length from static_json_size(value), see WWJSON_STATIC
+template <size_t N, typename valueT>
+constexpr StaticJson<N> static_json(const valueT& value)
+{
+    detail::StaticWriter<N> writer;
+    detail::static_put(writer, value);
+    return writer.json;
+}
+
+} // namespace wwjson
+
+/// @brief Compile-time JSON of a constexpr value, with the length computed
+/// @code
+/// constexpr auto kJson = WWJSON_STATIC(kTable);
+/// @endcode
+#ifndef WWJSON_STATIC
+#define WWJSON_STATIC(value) \
+    ::wwjson::static_json<::wwjson::static_json_size(value)>(value)
+#else
+#pragma message("WARNING: WWJSON_STATIC macro is already defined elsewhere")
+#endif
+
+#endif // JSTATIC_HPP__
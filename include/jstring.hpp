@@ -34,6 +34,45 @@
 
 namespace wwjson {
 
+namespace detail {
+
+/// @brief Growth policy shared by owning buffers.
+/// @param cur_size Current allocated bytes (0 if nothing allocated yet)
+/// @param req_size Requested allocation size in bytes
+/// @return New allocation size: exponential (2x) until JSTRING_MAX_EXP_ALLOC_SIZE,
+/// then linear growth by that amount, aligned to 8 bytes.
+inline size_t calculate_growth_size(size_t cur_size, size_t req_size)
+{
+    size_t new_size = req_size;
+    if (cur_size > 0)
+    {
+        if (cur_size < JSTRING_MAX_EXP_ALLOC_SIZE)
+        {
+            size_t exp_size = cur_size * 2;
+            if (exp_size > JSTRING_MAX_EXP_ALLOC_SIZE)
+            {
+                exp_size = JSTRING_MAX_EXP_ALLOC_SIZE;
+            }
+            
+            // Take maximum of requested and exponential growth
+            new_size = (new_size > exp_size) ? new_size : exp_size;
+        }
+        else
+        {
+            // Linear growth: add max_exp_size each time
+            size_t linear_size = cur_size + JSTRING_MAX_EXP_ALLOC_SIZE;
+            new_size = (new_size > linear_size) ? new_size : linear_size;
+        }
+    }
+    
+    // Align to 8-byte boundary
+    const size_t alignment = 8;
+    size_t aligned_size = (new_size + alignment - 1) & ~(alignment - 1);
+    return aligned_size;
+}
+
+} // namespace detail
+
 /// @brief Concept definition for unsafe string operations in JSON building
 /// @details
 /// This struct defines the interface for string types that support unsafe operations
@@ -235,6 +274,7 @@ public:
     /// @{ M2: Edge pointer and element access
 
     explicit operator bool() const { return m_begin != nullptr; }
+    char* data() { return m_begin; }
     const char* data() const { return m_begin; }
 
     char* begin() { return m_begin; }
@@ -504,6 +544,75 @@ public:
     }
 };
 
+/// @brief Deleter for memory allocated by malloc/realloc in owning buffers
+struct FreeDeleter
+{
+    void operator()(void* ptr) const noexcept { std::free(ptr); }
+};
+
+/// @brief Owning pointer to malloc'ed character array, freed with std::free
+using FreePtr = std::unique_ptr<char[], FreeDeleter>;
+
+/// @brief Memory block released from StringBuffer without copy
+/// @details
+/// Holds the exact allocation of a StringBuffer after release(): `size` bytes
+/// of content followed by '\0' (always terminated), within `capacity + 1`
+/// allocated bytes. It can be handed to other owners without copying the
+/// content, or given back to a StringBuffer to continue writing.
+///
+/// @par Adapters:
+/// - view(): std::string_view over the content (no copy)
+/// - share(): std::shared_ptr<char[]> taking the same memory (no copy)
+/// - to_string()/append_to(): std::string, one copy without zero filling
+///   (uses C++23 resize_and_overwrite when available)
+/// - StringBuffer(ReleasedBuffer&&): adopt it back (no copy)
+struct ReleasedBuffer
+{
+    FreePtr ptr;          ///< Owning pointer, may be null if nothing allocated
+    size_t size = 0;      ///< Content length, ptr[size] == '\0'
+    size_t capacity = 0;  ///< Usable bytes before the reserved terminator byte
+
+    const char* data() const { return ptr ? ptr.get() : ""; }
+    const char* c_str() const { return data(); }
+    bool empty() const { return size == 0; }
+    explicit operator bool() const { return ptr != nullptr; }
+
+    std::string_view view() const { return std::string_view(data(), size); }
+    operator std::string_view() const { return view(); }
+
+    /// Transfer ownership to shared_ptr (content is not copied).
+    std::shared_ptr<char[]> share() &&
+    {
+        size = 0;
+        capacity = 0;
+        return std::shared_ptr<char[]>(std::move(ptr));
+    }
+
+    /// Append content to std::string, skipping the zero fill of resize().
+    void append_to(std::string& dst) const
+    {
+#if defined(__cpp_lib_string_resize_and_overwrite)
+        size_t old_size = dst.size();
+        const char* src = data();
+        size_t len = size;
+        dst.resize_and_overwrite(old_size + len, [src, len, old_size](char* buf, size_t n) {
+            ::memcpy(buf + old_size, src, len);
+            return n;
+        });
+#else
+        dst.append(data(), size);
+#endif
+    }
+
+    /// Copy content to a new std::string.
+    std::string to_string() const
+    {
+        std::string result;
+        append_to(result);
+        return result;
+    }
+};
+
 /// @brief High-performance string buffer with unsafe operations
 /// @tparam kUnsafeLevel Number of additional bytes that can be written unsafely after a safe check
 /// @details
@@ -586,6 +695,19 @@ public:
         move_from(std::move(other));
     }
 
+    /// Adopt memory previously released from a StringBuffer (no copy).
+    explicit StringBuffer(ReleasedBuffer&& other) noexcept
+    {
+        if (other.ptr)
+        {
+            m_begin = other.ptr.release();
+            m_end = m_begin + other.size;
+            m_cap_end = m_begin + other.capacity;
+        }
+        other.size = 0;
+        other.capacity = 0;
+    }
+
     ~StringBuffer() { deallocate(); }
 
     StringBuffer& operator=(const StringBuffer& other)
@@ -687,6 +809,25 @@ public:
         unsafe_resize(new_size);
     }
 
+    /// @brief Give up ownership of the memory without copying content
+    /// @return Released block with '\0' terminated content, owned by caller
+    /// @details The buffer becomes empty with no memory; later writes
+    /// (explicit reserve for KString) allocate a new block. This is the zero-copy counterpart of str().
+    ReleasedBuffer release() noexcept
+    {
+        ReleasedBuffer result;
+        if (m_begin == nullptr) { return result; }
+
+        unsafe_end_cstr();  // m_end <= m_cap_end always holds for owned memory
+        result.size = size();
+        result.capacity = capacity();
+        result.ptr.reset(m_begin);
+        m_begin = nullptr;
+        m_end = nullptr;
+        m_cap_end = nullptr;
+        return result;
+    }
+
 private:
     static size_t calculate_alloc_size(size_t size)
     {
@@ -700,36 +841,6 @@ private:
         return aligned_size;
     }
 
-    static size_t calculate_growth_size(size_t cur_size, size_t req_size)
-    {
-        size_t new_size = req_size;
-        if (cur_size > 0)
-        {
-            if (cur_size < JSTRING_MAX_EXP_ALLOC_SIZE)
-            {
-                size_t exp_size = cur_size * 2;
-                if (exp_size > JSTRING_MAX_EXP_ALLOC_SIZE)
-                {
-                    exp_size = JSTRING_MAX_EXP_ALLOC_SIZE;
-                }
-                
-                // Take maximum of requested and exponential growth
-                new_size = (new_size > exp_size) ? new_size : exp_size;
-            }
-            else
-            {
-                // Linear growth: add max_exp_size each time
-                size_t linear_size = cur_size + JSTRING_MAX_EXP_ALLOC_SIZE;
-                new_size = (new_size > linear_size) ? new_size : linear_size;
-            }
-        }
-        
-        // Align to 8-byte boundary
-        const size_t alignment = 8;
-        size_t aligned_size = (new_size + alignment - 1) & ~(alignment - 1);
-        return aligned_size;
-    }
-
     void allocate(size_t size)
     {
         if (size == 0)
@@ -771,7 +882,7 @@ private:
             return;
         }
 
-        size_t alloc_size = calculate_growth_size(current_alloc, new_size);
+        size_t alloc_size = detail::calculate_growth_size(current_alloc, new_size);
 
         // Use realloc to attempt in-place expansion, avoiding memcpy when possible.
         // realloc behavior:
@@ -832,6 +943,234 @@ using JString = StringBuffer<4>;
 /// check overhead.
 using KString = StringBuffer<255>;
 
+/// @brief Buffer that starts on caller-provided memory and spills to heap
+/// @tparam LEVEL Number of additional bytes that can be written unsafely after a safe check
+/// @details
+/// SpillBuffer borrows a caller-provided memory region (typically a stack array
+/// or a socket buffer) like BufferView, but instead of truncating when the
+/// capacity runs out, it moves to a heap allocation, copying the written prefix
+/// once. After spilling it grows like StringBuffer (same growth policy).
+///
+/// @par Storage:
+/// - spilled() == false: content lives in the borrowed memory, not freed
+/// - spilled() == true: content lives in owned heap memory, freed on destruction
+/// - data()/begin()/end() always refer to whichever storage holds the result
+///
+/// @par Requirements:
+/// The borrowed region must be larger than kUnsafeLevel bytes, so the initial
+/// state already provides the unsafe margin (checked by assert / static_assert).
+///
+/// @par Usage Example:
+/// ```cpp
+/// char buf[256];
+/// SpillBuilder builder(SpillString(buf), 0);  // pass 0: do not reserve upfront
+/// builder.BeginObject();
+/// builder.AddMember("key", "value");
+/// builder.EndObject();
+/// std::string_view json = builder.GetResult();  // in buf unless spilled
+/// ```
+///
+/// @warning If not spilled, the result refers to the borrowed memory, which
+/// must outlive the SpillBuffer and any view taken from it.
+template <UnsafeLevel LEVEL>
+class SpillBuffer : public BufferView
+{
+protected:
+    bool m_heap = false;  ///< Whether the content has spilled to owned heap memory
+
+public:
+    static constexpr uint8_t kUnsafeLevel = LEVEL;
+
+    using BufferView::reserve_ex;
+
+    /// @{ M0: Constructors and assignment operators
+
+    /// Default constructor - no borrowed memory, the first reserve allocates heap.
+    SpillBuffer() = default;
+
+    /// @brief Borrow memory region to write first
+    /// @param dst Pointer to memory to borrow
+    /// @param size Size of the memory region (must be > kUnsafeLevel)
+    SpillBuffer(char* dst, size_t size) : BufferView(dst, size)
+    {
+        assert(size > kUnsafeLevel && "SpillBuffer constructor: size must be > kUnsafeLevel");
+    }
+
+    /// @brief Constructor from C array
+    template <size_t N>
+    explicit SpillBuffer(char (&dst)[N]) : SpillBuffer(dst, N)
+    {
+        static_assert(N > LEVEL, "SpillBuffer: array size must be > kUnsafeLevel");
+    }
+
+    /// @brief Constructor from std::array
+    template <size_t N>
+    explicit SpillBuffer(std::array<char, N>& dst) : SpillBuffer(dst.data(), N)
+    {
+        static_assert(N > LEVEL, "SpillBuffer: array size must be > kUnsafeLevel");
+    }
+
+    /// Copy constructor is deleted (may borrow memory)
+    SpillBuffer(const SpillBuffer&) = delete;
+
+    /// Move constructor - transfer borrowed or owned memory
+    SpillBuffer(SpillBuffer&& other) noexcept
+        : BufferView(std::move(other)), m_heap(other.m_heap)
+    {
+        other.m_heap = false;
+    }
+
+    /// Copy assignment is deleted (may borrow memory)
+    SpillBuffer& operator=(const SpillBuffer&) = delete;
+
+    /// Move assignment - free owned memory then transfer
+    SpillBuffer& operator=(SpillBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            deallocate();
+            BufferView::operator=(std::move(other));
+            m_heap = other.m_heap;
+            other.m_heap = false;
+        }
+        return *this;
+    }
+
+    ~SpillBuffer() { deallocate(); }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M1: Capacity management
+
+    /// Whether the content has moved to owned heap memory.
+    bool spilled() const { return m_heap; }
+
+    bool reserve_ex(size_t add_capacity)
+    {
+        try
+        {
+            reserve(size() + add_capacity);
+            return true;
+        }
+        catch (const std::bad_alloc&)
+        {
+            return false;
+        }
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        size_t total_capacity = new_capacity + kUnsafeLevel;
+        if (total_capacity > capacity())
+        {
+            spill(total_capacity + 1);
+        }
+    }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M2: Write operations that spill when needed
+
+    void append(const char* str)
+    {
+        if (str == nullptr) { return; }
+        append(str, ::strlen(str));
+    }
+
+    void append(const char* str, size_t len)
+    {
+        reserve_ex(len);
+        unsafe_append(str, len);
+    }
+
+    void append(const std::string& str)
+    {
+        append(str.data(), str.size());
+    }
+
+    void append(const std::string_view& sv)
+    {
+        append(sv.data(), sv.size());
+    }
+
+    void append(const BufferView& other)
+    {
+        append(other.data(), other.size());
+    }
+
+    void push_back(char c)
+    {
+        reserve_ex(1);
+        unsafe_push_back(c);
+    }
+
+    void append(size_t count, char ch)
+    {
+        reserve_ex(count);
+        unsafe_fill(ch, count);
+    }
+
+    void resize(size_t new_size)
+    {
+        reserve(new_size);
+        unsafe_resize(new_size);
+    }
+
+    /// @}
+
+private:
+    /// Move content to heap (first time) or grow heap memory (later).
+    void spill(size_t new_size)
+    {
+        size_t current_size = size();
+        size_t current_alloc = m_begin ? capacity() + 1 : 0;
+        size_t alloc_size = detail::calculate_growth_size(current_alloc, new_size);
+
+        char* new_begin = nullptr;
+        if (m_heap)
+        {
+            new_begin = static_cast<char*>(std::realloc(m_begin, alloc_size));
+        }
+        else
+        {
+            // Leave borrowed memory: copy the written prefix only once
+            new_begin = static_cast<char*>(std::malloc(alloc_size));
+            if (new_begin != nullptr && current_size > 0)
+            {
+                ::memcpy(new_begin, m_begin, current_size);
+            }
+        }
+
+        if (new_begin == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        m_heap = true;
+        m_begin = new_begin;
+        m_end = m_begin + current_size;
+        m_cap_end = m_begin + alloc_size - 1;
+        *m_cap_end = '\0';
+    }
+
+    void deallocate()
+    {
+        if (m_heap && m_begin)
+        {
+            std::free(m_begin);
+        }
+        m_heap = false;
+        m_begin = nullptr;
+        m_end = nullptr;
+        m_cap_end = nullptr;
+    }
+};
+
+/// @brief Spill buffer with the same unsafe level as JString
+/// @details Recommended for stack buffers on the hot path: writes in place
+/// while the caller's memory suffices, and moves to heap instead of overflowing.
+using SpillString = SpillBuffer<4>;
+
 } // namespace wwjson
 
 #endif // JSTRING_HPP__
@@ -0,0 +1,245 @@
+/**
+ * @file jtable.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Columnar data (struct of arrays) written as an array of objects
+ *
+ * @details This header provides TableWriter for query results held as
+ * column vectors, to write them row by row without transposing into structs:
+ * ```
+ * ts  = {1, 2}, val = {0.5, 1.5}, tag = {"a", "b"}
+ * -> [{"ts":1,"val":0.5,"tag":"a"},{"ts":2,"val":1.5,"tag":"b"}]
+ * ```
+ * The key fragments `{"ts":`, `,"val":`, `,"tag":` are rendered once per
+ * table, the value writer of each column is chosen at compile time from its
+ * element type, and the whole output is reserved once from a size estimate
+ * (exact maximum for numbers, sampled average for strings). Builders that do
+ * not check capacity on write (FastBuilder) also reserve before each cell.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * auto table = wwjson::make_table(wwjson::column("ts", ts),
+ *                                 wwjson::column("val", val),
+ *                                 wwjson::column("tag", tag));
+ * std::string json = table.Render();
+ * ```
+ *
+ * @note Column names are written as given, without escaping. Columns of
+ * different lengths are written up to the shortest one, see valid().
+ */
+
+#pragma once
+#ifndef JTABLE_HPP__
+#define JTABLE_HPP__
+
+#include "jfields.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace wwjson {
+
+/// @brief Named column referring to a random-access container
+/// @details The container (std::vector, std::array, ...) is referenced, and
+/// must outlive the writer.
+template <typename containerT>
+struct Column
+{
+    std::string_view name;
+    const containerT* data;
+};
+
+/// Make a named column of a container.
+template <typename containerT>
+Column<containerT> column(std::string_view name, const containerT& data)
+{
+    return Column<containerT>{name, &data};
+}
+
+namespace detail {
+
+/// Estimated JSON size of a column's values, in total for `rows` rows.
+template <typename configT, typename containerT>
+size_t column_json_size(const containerT& data, size_t rows)
+{
+    using valueT = typename containerT::value_type;
+    if constexpr (max_json_size<valueT, configT>::bounded)
+    {
+        return rows * max_json_size<valueT, configT>::value;
+    }
+    else if constexpr (is_key_v<valueT>)
+    {
+        // strings: average of a sample, escaping not counted
+        size_t sample = rows < 64 ? rows : 64;
+        size_t bytes = 0;
+        for (size_t i = 0; i < sample; ++i) { bytes += std::string_view(data[i]).size(); }
+        return rows * ((sample > 0 ? bytes / sample : 0) + 2);
+    }
+    else
+    {
+        return rows * 16;
+    }
+}
+
+/// @brief Room for a column value in a builder not checking capacity on write
+/// @details Maximum size for numbers, exact size for strings; nested values
+/// are left to their own writers.
+template <typename configT, typename valueT>
+size_t column_value_room(const valueT& value)
+{
+    if constexpr (max_json_size<valueT, configT>::bounded)
+    {
+        return max_json_size<valueT, configT>::value;
+    }
+    else if constexpr (is_optional_v<valueT>)
+    {
+        return value.has_value() ? column_value_room<configT>(value.value()) : 4;
+    }
+    else if constexpr (is_key_v<valueT>)
+    {
+        return std::string_view(value).size() * (configT::kEscapeValue ? 2 : 1) + 2;
+    }
+    else
+    {
+        (void)value;
+        return 0;
+    }
+}
+
+} // namespace detail
+
+/// @brief Writer of equal-length columns as a JSON array of row objects
+/// @tparam containerTs Container types of the columns
+template <typename... containerTs>
+class TableWriter
+{
+    static_assert(sizeof...(containerTs) > 0, "a table needs at least one column");
+    static constexpr size_t kColumns = sizeof...(containerTs);
+
+public:
+    explicit TableWriter(const Column<containerTs>&... columns)
+        : m_columns(columns...)
+    {
+        size_t sizes[] = {columns.data->size()...};
+        m_rows = sizes[0];
+        m_valid = true;
+        for (size_t size : sizes)
+        {
+            if (size != m_rows) { m_valid = false; }
+            if (size < m_rows) { m_rows = size; }
+        }
+
+        // fragment i: `{"name":` for the first column, `,"name":` for others
+        size_t i = 0;
+        auto render = [&](const auto& col) {
+            m_offset[i] = m_text.size();
+            m_text.push_back(i == 0 ? '{' : ',');
+            m_text.push_back('"');
+            m_text.append(col.name.data(), col.name.size());
+            m_text.append("\":", 2);
+            ++i;
+        };
+        (render(columns), ...);
+        m_offset[kColumns] = m_text.size();
+    }
+
+    /// Number of rows written, the shortest column length.
+    size_t rows() const { return m_rows; }
+
+    /// False if the columns have different lengths.
+    bool valid() const { return m_valid; }
+
+    /// Key fragment of column i, with its leading '{' or ','.
+    std::string_view fragment(size_t i) const
+    {
+        return std::string_view(m_text.data() + m_offset[i], m_offset[i + 1] - m_offset[i]);
+    }
+
+    /// @brief Estimated output size, reserved once by Write()
+    template <typename configT = UnsafeConfig<JString>>
+    size_t EstimateSize() const
+    {
+        size_t per_row = m_text.size() + 2;  // fragments, `},`
+        size_t total = 2 + m_rows * per_row;
+        std::apply([&](const auto&... col) {
+            ((total += detail::column_json_size<configT>(*col.data, m_rows)), ...);
+        }, m_columns);
+        return total;
+    }
+
+    /// @brief Append the table as an array to a builder, with trailing comma
+    template <typename builderT>
+    void Write(builderT& builder) const
+    {
+        builder.Reserve(EstimateSize<typename builderT::config_type>());
+        builder.BeginArray();
+        for (size_t row = 0; row < m_rows; ++row)
+        {
+            WriteRow(builder, row, std::make_index_sequence<kColumns>{});
+        }
+        builder.EndArray();
+    }
+
+    /// @brief Append the table as member `key` of an object
+    template <typename builderT, typename keyT>
+    void Write(builderT& builder, keyT&& key) const
+    {
+        builder.PutKey(std::forward<keyT>(key));
+        Write(builder);
+    }
+
+    /// @brief Render the table to a new string
+    /// @tparam resultT std::string (default), JString or ReleasedBuffer
+    template <typename resultT = std::string>
+    resultT Render() const
+    {
+        Builder builder(EstimateSize());
+        Write(builder);
+        return detail::move_result<resultT>(builder);
+    }
+
+private:
+    template <typename builderT, size_t... Is>
+    void WriteRow(builderT& builder, size_t row, std::index_sequence<Is...>) const
+    {
+        bool comma = false;
+        auto step = [&](size_t i, const auto& col) {
+            std::string_view frag = fragment(i);
+            using valueT = typename std::decay_t<decltype(*col.data)>::value_type;
+            const valueT& value = (*col.data)[row];  // a copy for vector<bool>
+            if constexpr (detail::unsafe_level_v<typename builderT::string_type> >= 0xFF)
+            {
+                // KString: the estimate of Write() is not a bound for strings
+                builder.Reserve(frag.size() +
+                    detail::column_value_room<typename builderT::config_type>(value));
+            }
+            builder.Append(frag.data() + comma, frag.size() - comma);
+            comma = detail::put_field_value(builder, value);
+        };
+        (step(Is, std::get<Is>(m_columns)), ...);
+        if (comma) { builder.EndObject(); }
+        else { builder.Append("},", 2); }
+    }
+
+    std::tuple<Column<containerTs>...> m_columns;
+    std::string m_text;                           ///< Key fragments back to back
+    std::array<size_t, kColumns + 1> m_offset{};  ///< Start of each fragment, then the end
+    size_t m_rows = 0;
+    bool m_valid = true;
+};
+
+/// Make a TableWriter from named columns.
+template <typename... containerTs>
+TableWriter<containerTs...> make_table(const Column<containerTs>&... columns)
+{
+    return TableWriter<containerTs...>(columns...);
+}
+
+} // namespace wwjson
+
+#endif // JTABLE_HPP__
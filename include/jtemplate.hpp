@@ -0,0 +1,213 @@
+/**
+ * @file jtemplate.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Compile-time JSON templates with typed value holes
+ *
+ * @details This header provides JsonTemplate and the WWJSON_TEMPLATE macro,
+ * for responses that have a fixed skeleton with a few variable values:
+ * ```cpp
+ * static constexpr auto tpl = WWJSON_TEMPLATE(R"({"code":{},"msg":{},"data":{"id":{}}})");
+ * std::string json = tpl.Render(200, "OK", user_id);
+ * ```
+ * The template text is split at each `{}` hole into literal segments at
+ * compile time. Rendering is then one reserve of the known literal size plus
+ * the value estimates, followed by segment copies alternating with typed
+ * value writes (the builder's NumberString for numbers, PutValue with the
+ * configured escaping for strings). Unlike snprintf, no format string is
+ * interpreted at run time.
+ *
+ * Each hole takes one complete JSON value: numbers and bools as is (quoted
+ * when configT::kQuoteNumber), strings quoted, nullptr and empty optionals
+ * as null.
+ *
+ * @note Every `{}` in the template is a hole, write an empty object literal
+ * as `{ }`. The number of render arguments is checked at compile time.
+ */
+
+#pragma once
+#ifndef JTEMPLATE_HPP__
+#define JTEMPLATE_HPP__
+
+#include "jbuilder.hpp"
+
+#include <array>
+#include <string_view>
+
+namespace wwjson {
+
+namespace detail {
+
+/// Count `{}` holes of a template text at compile time.
+template <size_t N>
+constexpr size_t count_holes(const char (&text)[N])
+{
+    size_t count = 0;
+    for (size_t i = 0; i + 1 < N; ++i)
+    {
+        if (text[i] == '{' && text[i + 1] == '}')
+        {
+            ++count;
+            ++i;
+        }
+    }
+    return count;
+}
+
+/// Expected output size of a template value, for the up-front reserve.
+template <typename valueT>
+size_t template_value_size(const valueT& value)
+{
+    if constexpr (is_optional_v<valueT>)
+    {
+        return value.has_value() ? template_value_size(value.value()) : 4;
+    }
+    else if constexpr (std::is_same_v<valueT, bool>)
+    {
+        return 5;
+    }
+    else if constexpr (std::is_arithmetic_v<valueT>)
+    {
+        return 24;  // max int64 digits or shortest double, with quotes
+    }
+    else if constexpr (std::is_same_v<valueT, std::string> || std::is_same_v<valueT, std::string_view>)
+    {
+        return value.size() + 2;
+    }
+    else
+    {
+        return 16;
+    }
+}
+
+/// Write one template value as a complete JSON value, no separator.
+template <typename builderT, typename valueT>
+void put_template_value(builderT& builder, const valueT& value)
+{
+    using configT = typename builderT::config_type;
+    if constexpr (is_optional_v<valueT>)
+    {
+        if (value.has_value()) { put_template_value(builder, value.value()); }
+        else { builder.PutNull(); }
+    }
+    else if constexpr (std::is_same_v<valueT, std::nullptr_t>)
+    {
+        builder.PutNull();
+    }
+    else if constexpr (std::is_arithmetic_v<valueT>)
+    {
+        if constexpr (configT::kQuoteNumber)
+        {
+            builder.UnsafePutChar('"');
+            builder.PutValue(value);
+            builder.UnsafePutChar('"');
+        }
+        else
+        {
+            builder.PutValue(value);
+        }
+    }
+    else
+    {
+        static_assert(is_key_v<valueT> || std::is_convertible_v<valueT, const char*>,
+            "template value must be a number, bool, string, nullptr or optional of them");
+        builder.PutValue(value);
+    }
+}
+
+} // namespace detail
+
+/// @brief JSON text with `{}` holes, split into literal segments at compile time
+/// @tparam kHoles Number of value holes
+/// @tparam N Size of the template literal, bounds the stored segment bytes
+/// @details Construct with WWJSON_TEMPLATE, preferably as a static constexpr
+/// object so that the segments live in read-only data.
+template <size_t kHoles, size_t N>
+class JsonTemplate
+{
+public:
+    static constexpr size_t kValues = kHoles;
+
+    constexpr explicit JsonTemplate(const char (&text)[N])
+    {
+        size_t pos = 0;
+        size_t hole = 0;
+        for (size_t i = 0; i + 1 < N; ++i)
+        {
+            if (text[i] == '{' && text[i + 1] == '}')
+            {
+                m_offset[++hole] = static_cast<uint32_t>(pos);
+                ++i;
+                continue;
+            }
+            m_text[pos++] = text[i];
+        }
+        m_offset[kHoles + 1] = static_cast<uint32_t>(pos);
+    }
+
+    /// Total bytes of literal segments, the minimum rendered size.
+    constexpr size_t literal_size() const { return m_offset[kHoles + 1]; }
+
+    /// Literal segment i (0 <= i <= kHoles), hole i follows segment i.
+    constexpr std::string_view segment(size_t i) const
+    {
+        return std::string_view(m_text.data() + m_offset[i], m_offset[i + 1] - m_offset[i]);
+    }
+
+    /// @brief Append the rendered template to a builder, no trailing comma
+    /// @param args One value per hole, in order
+    template <typename builderT, typename... argsT>
+    void Write(builderT& builder, const argsT&... args) const
+    {
+        static_assert(sizeof...(argsT) == kHoles, "one argument per template hole");
+        builder.Reserve(literal_size() + (detail::template_value_size(args) + ... + 0));
+        if constexpr (kHoles > 0)
+        {
+            size_t i = 0;
+            auto put = [&](const auto& arg) {
+                PutSegment(builder, i++);
+                detail::put_template_value(builder, arg);
+            };
+            (put(args), ...);
+        }
+        PutSegment(builder, kHoles);
+    }
+
+    /// @brief Render the template to a new string
+    /// @tparam resultT std::string (default), JString or ReleasedBuffer
+    template <typename resultT = std::string, typename... argsT>
+    resultT Render(const argsT&... args) const
+    {
+        Builder builder(literal_size() + 16 * kHoles);
+        Write(builder, args...);
+        return detail::move_result<resultT>(builder);
+    }
+
+private:
+    template <typename builderT>
+    void PutSegment(builderT& builder, size_t i) const
+    {
+        size_t len = m_offset[i + 1] - m_offset[i];
+        if (len > 0) { builder.Append(m_text.data() + m_offset[i], len); }
+    }
+
+    std::array<char, N> m_text{};
+    std::array<uint32_t, kHoles + 2> m_offset{};
+};
+
+} // namespace wwjson
+
+/// @brief Define a JsonTemplate from a string literal with `{}` holes
+/// @code
+/// static constexpr auto tpl = WWJSON_TEMPLATE(R"({"id":{},"name":{}})");
+/// @endcode
+#ifndef WWJSON_TEMPLATE
+#define WWJSON_TEMPLATE(text) \
+    ::wwjson::JsonTemplate<::wwjson::detail::count_holes(text), sizeof(text)>(text)
+#else
+#pragma message("WARNING: WWJSON_TEMPLATE macro is already defined elsewhere")
+#endif
+
+#endif // JTEMPLATE_HPP__
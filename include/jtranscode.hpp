@@ -0,0 +1,366 @@
+/**
+ * @file jtranscode.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Streaming rewrite of a JSON text into a builder
+ *
+ * @details Rewriting upstream JSON (drop fields, rename keys, change number
+ * quoting) usually means parse to a DOM and rebuild. transcode() instead
+ * tokenizes the input once and drives the builder directly: BeginObject,
+ * EndArray, keys and values follow the input, while untouched strings and
+ * numbers are copied through as raw tokens, never decoded, re-escaped or
+ * re-formatted. A dropped member is skipped structurally as in jscan.hpp,
+ * without producing any token.
+ *
+ * Rules are keyed by member path, the member names from the root joined
+ * with '.', array levels being transparent: in
+ * `{"data":{"items":[{"id":1}]}}` the id member is at `data.items.id`. A
+ * path `*.name` matches the member name at any depth. A rule on an array
+ * member applies to its scalar items as well.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * wwjson::TranscodeRules rules;
+ * rules.Drop("debug").Drop("*.internal")
+ *      .Rename("data.items.ts", "time")
+ *      .Quote("data.items.id");          // 123 -> "123" for JS clients
+ * wwjson::Builder builder;
+ * if (!wwjson::transcode(builder, upstream, rules)) { ... }
+ * ```
+ *
+ * @note Strings are copied verbatim, escapes included, so the output keeps
+ * the escaping of the input. Malformed input stops the transcoding with
+ * false; what was written to the builder so far is left to the caller.
+ */
+
+#pragma once
+#ifndef JTRANSCODE_HPP__
+#define JTRANSCODE_HPP__
+
+#include "jbuilder.hpp"
+#include "jscan.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wwjson {
+
+/// @brief Member rules applied by transcode()
+class TranscodeRules
+{
+public:
+    /// Change of a member's scalar values.
+    enum Quoting : uint8_t
+    {
+        kAsIs,    ///< Copy the value token
+        kQuote,   ///< Write a number, true, false or null as a string
+        kUnquote, ///< Write a string holding a number as a bare number
+    };
+
+    struct Rule
+    {
+        bool drop = false;       ///< Remove the member and its value
+        Quoting quoting = kAsIs;
+        std::string name;        ///< New key if not empty
+    };
+
+    TranscodeRules& Drop(std::string_view path)
+    {
+        Add(path).drop = true;
+        return *this;
+    }
+    TranscodeRules& Rename(std::string_view path, std::string_view name)
+    {
+        Add(path).name.assign(name.data(), name.size());
+        return *this;
+    }
+    TranscodeRules& Quote(std::string_view path)
+    {
+        Add(path).quoting = kQuote;
+        return *this;
+    }
+    TranscodeRules& Unquote(std::string_view path)
+    {
+        Add(path).quoting = kUnquote;
+        return *this;
+    }
+
+    bool empty() const { return m_rules.empty(); }
+
+    /// @brief Rule of a member
+    /// @param path Full path of the member
+    /// @param key Its own name, the last part of path
+    /// @return nullptr if no rule matches
+    const Rule* Find(std::string_view path, std::string_view key) const
+    {
+        auto it = m_rules.find(path);
+        if (it != m_rules.end()) { return &it->second; }
+        if (m_any > 0)
+        {
+            m_probe.assign("*.", 2);
+            m_probe.append(key.data(), key.size());
+            it = m_rules.find(m_probe);
+            if (it != m_rules.end()) { return &it->second; }
+        }
+        return nullptr;
+    }
+
+private:
+    Rule& Add(std::string_view path)
+    {
+        auto it = m_rules.find(path);
+        if (it != m_rules.end()) { return it->second; }
+        if (path.size() > 2 && path[0] == '*' && path[1] == '.') { ++m_any; }
+        return m_rules[std::string(path)];
+    }
+
+    std::map<std::string, Rule, std::less<>> m_rules;
+    size_t m_any = 0;             ///< Number of `*.name` rules
+    mutable std::string m_probe;  ///< Lookup buffer for `*.name`
+};
+
+namespace detail {
+
+/// True if a string body is exactly one JSON number, safe to unquote.
+inline bool is_number_text(std::string_view text)
+{
+    if (text.empty()) { return false; }
+    const char* end = text.data() + text.size();
+    return valid_number(text.data(), end) == end;
+}
+
+/// Token loop of transcode(), with an explicit stack of open containers.
+template <typename builderT>
+class Transcoder
+{
+    using Rule = TranscodeRules::Rule;
+    using Quoting = TranscodeRules::Quoting;
+
+    struct Frame
+    {
+        bool object;
+        size_t path_size;   ///< Length of the path of the container
+        const Rule* rule;   ///< Rule of the container, passed to its items
+    };
+
+public:
+    Transcoder(builderT& builder, const TranscodeRules& rules)
+        : m_builder(builder), m_rules(rules)
+    {
+        m_stack.reserve(16);
+    }
+
+    bool Run(std::string_view input)
+    {
+        m_end = input.data() + input.size();
+        const char* p = input.data();
+        const Rule* rule = nullptr;
+        m_stack.clear();
+        m_path.clear();
+
+        for (;;)
+        {
+            // a value, with the rule of its member or array
+            p = scan_ws(p, m_end);
+            if (wwjson_unlikely(p >= m_end)) { return false; }
+            if (*p == '{' || *p == '[')
+            {
+                bool object = (*p == '{');
+                if (object) { m_builder.BeginObject(); }
+                else { m_builder.BeginArray(); }
+                // path of the container: its member, or that of its array
+                size_t path_size = m_path.size();
+                if (!m_stack.empty() && !m_stack.back().object) { path_size = m_stack.back().path_size; }
+                m_stack.push_back(Frame{object, path_size, rule});
+                p = scan_ws(p + 1, m_end);
+                if (p < m_end && *p == (object ? '}' : ']'))
+                {
+                    Close();
+                    ++p;
+                }
+                else if (object)
+                {
+                    p = Member(p, rule);
+                    if (p == nullptr) { return false; }
+                    if (rule != nullptr && rule->drop) { goto next; }
+                    continue;
+                }
+                else
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                p = Scalar(p, rule);
+                if (p == nullptr) { return false; }
+            }
+
+        next:
+            // separators and closers after a value or a dropped member
+            for (;;)
+            {
+                if (m_stack.empty())
+                {
+                    return scan_ws(p, m_end) == m_end;
+                }
+                p = scan_ws(p, m_end);
+                if (wwjson_unlikely(p >= m_end)) { return false; }
+                Frame& top = m_stack.back();
+                if (*p == ',')
+                {
+                    p = scan_ws(p + 1, m_end);
+                    if (!top.object)
+                    {
+                        rule = top.rule;
+                        break;
+                    }
+                    p = Member(p, rule);
+                    if (p == nullptr) { return false; }
+                    if (rule != nullptr && rule->drop) { continue; }
+                    break;
+                }
+                if (*p != (top.object ? '}' : ']')) { return false; }
+                Close();
+                ++p;
+            }
+        }
+    }
+
+private:
+    /// @brief Read a key and its colon, apply its rule
+    /// @return After the colon, or after the value if dropped; nullptr if
+    /// malformed
+    const char* Member(const char* p, const Rule*& rule)
+    {
+        if (p >= m_end || *p != '"') { return nullptr; }
+        const char* q = scan_string(p + 1, m_end);
+        if (wwjson_unlikely(q == nullptr)) { return nullptr; }
+        std::string_view key(p + 1, static_cast<size_t>(q - p - 2));
+
+        rule = nullptr;
+        if (!m_rules.empty())
+        {
+            m_path.resize(m_stack.back().path_size);
+            if (!m_path.empty()) { m_path.push_back('.'); }
+            m_path.append(key.data(), key.size());
+            rule = m_rules.Find(m_path, key);
+        }
+
+        const char* value = scan_ws(q, m_end);
+        if (value >= m_end || *value != ':') { return nullptr; }
+        value = scan_ws(value + 1, m_end);
+        if (rule != nullptr)
+        {
+            if (rule->drop) { return scan_value(value, m_end); }
+            if (!rule->name.empty())
+            {
+                ReserveGrowth(value, rule->name.size() * 2 + 3);
+                m_builder.PutKey(rule->name);
+                return value;
+            }
+        }
+        m_builder.PutSub(p, static_cast<size_t>(q - p));
+        m_builder.PutChar(':');
+        return value;
+    }
+
+    /// Copy a string or scalar token, re-quoted by the rule if any.
+    const char* Scalar(const char* p, const Rule* rule)
+    {
+        const char* q = scan_value(p, m_end);
+        if (wwjson_unlikely(q == nullptr || q == p)) { return nullptr; }
+        size_t len = static_cast<size_t>(q - p);
+        Quoting quoting = rule != nullptr ? rule->quoting : TranscodeRules::kAsIs;
+        if (*p == '"')
+        {
+            std::string_view body(p + 1, len - 2);
+            if (quoting == TranscodeRules::kUnquote && is_number_text(body))
+            {
+                m_builder.PutSub(body);
+            }
+            else
+            {
+                m_builder.PutSub(p, len);
+            }
+        }
+        else if (quoting == TranscodeRules::kQuote)
+        {
+            ReserveGrowth(p, 2);
+            m_builder.PutChar('"');
+            m_builder.PutSub(p, len);
+            m_builder.PutChar('"');
+        }
+        else
+        {
+            m_builder.PutSub(p, len);
+        }
+        m_builder.SepItem();
+        return q;
+    }
+
+    /// @brief Keep room for the rest of the input plus `extra` bytes
+    /// @details The output is reserved as long as the input, which the rules
+    /// may outgrow; builders not checking capacity on write (KString) are
+    /// reserved again before each such growth.
+    void ReserveGrowth(const char* p, size_t extra)
+    {
+        if constexpr (unsafe_level_v<typename builderT::string_type> >= 0xFF)
+        {
+            m_builder.Reserve(static_cast<size_t>(m_end - p) + extra);
+        }
+        else
+        {
+            (void)p;
+            (void)extra;
+        }
+    }
+
+    void Close()
+    {
+        if (m_stack.back().object) { m_builder.EndObject(); }
+        else { m_builder.EndArray(); }
+        m_stack.pop_back();
+    }
+
+    builderT& m_builder;
+    const TranscodeRules& m_rules;
+    const char* m_end = nullptr;
+    std::vector<Frame> m_stack;
+    std::string m_path;
+};
+
+} // namespace detail
+
+/// @brief Rewrite a JSON text into a builder by member rules
+/// @param builder Builder to append to, with trailing comma as AddItem
+/// @param input Well-formed JSON text
+/// @param rules Member rules, may be empty for a plain copy
+/// @return false if the input is malformed
+template <typename builderT>
+bool transcode(builderT& builder, std::string_view input, const TranscodeRules& rules)
+{
+    builder.Reserve(input.size());
+    detail::Transcoder<builderT> transcoder(builder, rules);
+    return transcoder.Run(input);
+}
+
+/// @brief Rewrite a JSON text into a new string
+/// @tparam resultT std::string (default), JString or ReleasedBuffer
+/// @return Empty result if the input is malformed
+template <typename resultT = std::string>
+resultT transcode(std::string_view input, const TranscodeRules& rules)
+{
+    Builder builder(input.size() + 16);
+    if (!transcode(builder, input, rules)) { return resultT(); }
+    return detail::move_result<resultT>(builder);
+}
+
+} // namespace wwjson
+
+#endif // JTRANSCODE_HPP__
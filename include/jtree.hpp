@@ -0,0 +1,160 @@
+/**
+ * @file jtree.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Iterative serialization of deeply nested trees
+ *
+ * @details The to_json_impl rules recurse once per nesting level, so a tree
+ * of user nodes (comment threads, syntax trees) thousands of levels deep may
+ * overflow the call stack, and on narrow deep shapes the call overhead
+ * dominates. to_json_tree() writes the same output with a loop over an
+ * explicit, heap allocated stack of frames, one per open level holding only
+ * a pair of iterators into the children. The call stack stays constant
+ * whatever the depth.
+ *
+ * The tree shape is given by a TreeTraits specialization for the node type:
+ * ```cpp
+ * template <> struct wwjson::TreeTraits<Comment>
+ * {
+ *     static constexpr const char* kChildrenKey = "replies";
+ *     static const auto& Children(const Comment& node) { return node.replies; }
+ *     template <typename builderT>
+ *     static void WriteFields(builderT& builder, const Comment& node)
+ *     {
+ *         builder.AddMember("id", node.id);
+ *         builder.AddMember("text", node.text);
+ *     }
+ * };
+ * std::string json = wwjson::to_json_tree(root);
+ * ```
+ * Each node is written as `{<fields>,"replies":[<children>]}`, exactly what
+ * a recursive `to_json(builder)` method writing the fields and then
+ * `TO_JSON(replies)` would produce. Children may be nodes or pointers to
+ * nodes (raw, unique_ptr, shared_ptr); a null pointer is written as null.
+ */
+
+#pragma once
+#ifndef JTREE_HPP__
+#define JTREE_HPP__
+
+#include "jbuilder.hpp"
+
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace wwjson {
+
+/// @brief Shape of a tree node type, to be specialized by the user
+/// @details A specialization provides:
+/// - `kChildrenKey`: key of the children array;
+/// - `Children(node)`: container of child nodes or pointers to them;
+/// - `WriteFields(builder, node)`: the other members, as AddMember calls.
+template <typename nodeT>
+struct TreeTraits;
+
+namespace detail {
+
+template <typename T, typename = void>
+struct is_pointer_like : std::false_type {};
+
+template <typename T>
+struct is_pointer_like<T, std::void_t<decltype(*std::declval<const T&>()),
+                                      decltype(static_cast<bool>(std::declval<const T&>()))>>
+    : std::true_type {};
+
+/// Iterative writer of one tree, reusing the frame stack across nodes.
+template <typename builderT, typename nodeT>
+class TreeWriter
+{
+    using traits = TreeTraits<nodeT>;
+    using childrenT = std::decay_t<decltype(traits::Children(std::declval<const nodeT&>()))>;
+    using iterator = decltype(std::cbegin(std::declval<const childrenT&>()));
+
+    struct Frame
+    {
+        iterator it;
+        iterator end;
+    };
+
+public:
+    explicit TreeWriter(builderT& builder) : m_builder(builder) { m_stack.reserve(64); }
+
+    void Write(const nodeT& root)
+    {
+        Open(root);
+        while (!m_stack.empty())
+        {
+            Frame& top = m_stack.back();
+            if (top.it == top.end)
+            {
+                m_stack.pop_back();
+                m_builder.EndArray();
+                m_builder.EndObject();
+                continue;
+            }
+            const auto& child = *top.it;
+            ++top.it;  // before Open, which may grow the stack
+            if constexpr (is_pointer_like<std::decay_t<decltype(child)>>::value)
+            {
+                if (child) { Open(*child); }
+                else { m_builder.AddItem(nullptr); }
+            }
+            else
+            {
+                Open(child);
+            }
+        }
+    }
+
+private:
+    /// Write the node up to its children array, pushing a frame if any.
+    void Open(const nodeT& node)
+    {
+        m_builder.BeginObject();
+        traits::WriteFields(m_builder, node);
+        m_builder.PutKey(traits::kChildrenKey);
+        m_builder.BeginArray();
+        const childrenT& children = traits::Children(node);
+        auto it = std::cbegin(children);
+        auto end = std::cend(children);
+        if (it == end)
+        {
+            m_builder.EndArray();
+            m_builder.EndObject();
+            return;
+        }
+        m_stack.push_back(Frame{it, end});
+    }
+
+    builderT& m_builder;
+    std::vector<Frame> m_stack;
+};
+
+} // namespace detail
+
+/// @brief Serialize a tree to a builder with an explicit stack
+/// @param root Root node, whose type has a TreeTraits specialization
+template <typename builderT, typename nodeT>
+void to_json_tree(builderT& builder, const nodeT& root)
+{
+    detail::TreeWriter<builderT, nodeT> writer(builder);
+    writer.Write(root);
+}
+
+/// @brief Serialize a tree to a new string with an explicit stack
+/// @tparam resultT std::string (default), JString or ReleasedBuffer
+template <typename resultT = std::string, typename nodeT>
+resultT to_json_tree(const nodeT& root)
+{
+    Builder builder;
+    to_json_tree(builder, root);
+    return detail::move_result<resultT>(builder);
+}
+
+} // namespace wwjson
+
+#endif // JTREE_HPP__
@@ -0,0 +1,635 @@
+/**
+ * @file juring.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Asynchronous output of built JSON documents via Linux io_uring
+ *
+ * @details This header provides AsyncWriter, which takes finished JString
+ * buffers (e.g. from Builder::MoveResult) and submits them to a file
+ * descriptor through io_uring, so the builder thread can start the next
+ * document without waiting on I/O. Buffers are returned to an internal pool
+ * on completion and can be acquired again for the next builder, avoiding
+ * reallocation.
+ *
+ * The io_uring ring is driven by raw syscalls (no liburing dependency).
+ * When io_uring is unavailable (non-Linux, old kernel, or forbidden by a
+ * sandbox), AsyncWriter falls back to synchronous write with the same API.
+ * Define WWJSON_NO_IO_URING to force the fallback.
+ *
+ * @note AsyncWriter is not thread-safe: use one writer per builder thread.
+ */
+
+#pragma once
+#ifndef JURING_HPP__
+#define JURING_HPP__
+
+#include "jsink.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && !defined(WWJSON_NO_IO_URING) && __has_include(<linux/io_uring.h>)
+#define WWJSON_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define WWJSON_HAS_IO_URING 0
+#endif
+
+namespace wwjson {
+
+/// @brief Pool of reusable JString buffers
+/// @details Recycled buffers are cleared but keep their capacity, so a
+/// builder constructed from an acquired buffer usually does not allocate.
+class BufferPool
+{
+public:
+    static constexpr size_t kDefaultMaxPooled = 64;
+
+    explicit BufferPool(size_t max_pooled = kDefaultMaxPooled)
+        : m_maxPooled(max_pooled)
+    {
+    }
+
+    /// Take a buffer from pool, or create one with `capacity` if empty.
+    JString acquire(size_t capacity = JString::kDefaultAllocate)
+    {
+        if (m_free.empty())
+        {
+            return JString(capacity);
+        }
+        JString buf = std::move(m_free.back());
+        m_free.pop_back();
+        if (buf.capacity() < capacity)
+        {
+            return JString(capacity);
+        }
+        return buf;
+    }
+
+    /// Give a buffer back for later reuse (dropped if pool is full).
+    void recycle(JString&& buf)
+    {
+        if (m_free.size() < m_maxPooled && buf.capacity() > 0)
+        {
+            buf.clear();
+            m_free.push_back(std::move(buf));
+        }
+    }
+
+    size_t size() const { return m_free.size(); }
+
+private:
+    std::vector<JString> m_free;
+    size_t m_maxPooled;
+};
+
+/// @brief Write finished JSON buffers to a fd asynchronously
+/// @details
+/// submit() takes ownership of a JString and gathers it into the current
+/// batch. A batch is committed as one writev request when it reaches
+/// `batch_bytes` or the iovec limit, or explicitly by commit()/drain().
+/// Completions are reaped on later submit()/poll()/drain() calls, and the
+/// buffers are recycled into the pool that acquire() draws from.
+///
+/// @par Ordering:
+/// - Seekable fd (regular file without O_APPEND): each batch is written at
+///   an explicit offset following the previous one, so many writes may be
+///   in flight while the file content stays in submission order.
+/// - Stream fd (pipe, socket, O_APPEND file): at most one write is in
+///   flight and the rest wait in order, still without blocking the caller.
+/// Short writes are resubmitted for the remaining bytes.
+///
+/// @par Usage Example:
+/// ```cpp
+/// AsyncWriter writer(fd);
+/// for (auto& msg : messages) {
+///     Builder builder(writer.acquire(), 0);
+///     builder.BeginObject();
+///     builder.AddMember("id", msg.id);
+///     builder.EndObject();
+///     builder.PutChar('\n');
+///     writer.submit(builder.MoveResult());
+/// }
+/// writer.drain();  // wait all writes; destructor also drains
+/// ```
+class AsyncWriter
+{
+public:
+    static constexpr unsigned kDefaultDepth = 64;
+    static constexpr size_t kDefaultBatchBytes = 64 * 1024;
+    static constexpr size_t kMaxBatchBuffers = 64;  ///< iovec count per write
+
+    /// @brief Create writer for fd (not closed by the writer)
+    /// @param fd Destination file descriptor
+    /// @param depth Max writes in flight, also the io_uring queue size
+    /// @param batch_bytes Gathered size that triggers a write, 0 to write
+    /// every submitted buffer immediately
+    explicit AsyncWriter(int fd, unsigned depth = kDefaultDepth,
+                         size_t batch_bytes = kDefaultBatchBytes)
+        : m_fd(fd), m_batchBytes(batch_bytes), m_pool(kMaxBatchBuffers * 2)
+    {
+        if (depth == 0) { depth = 1; }
+        m_slots.resize(depth);
+        for (unsigned i = depth; i > 0; --i)
+        {
+            m_freeSlots.push_back(i - 1);
+        }
+
+        int flags = ::fcntl(fd, F_GETFL);
+        off_t pos = ::lseek(fd, 0, SEEK_CUR);
+        if (pos >= 0 && flags >= 0 && !(flags & O_APPEND))
+        {
+            m_seekable = true;
+            m_offset = static_cast<uint64_t>(pos);
+        }
+
+#if WWJSON_HAS_IO_URING
+        m_ring.setup(depth);
+#endif
+    }
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    ~AsyncWriter()
+    {
+        drain();
+    }
+
+    /// @{ M0: Buffer pool
+
+    /// Acquire an empty buffer to build the next document into.
+    JString acquire(size_t capacity = JString::kDefaultAllocate)
+    {
+        return m_pool.acquire(capacity);
+    }
+
+    BufferPool& pool() { return m_pool; }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M1: Submission and completion
+
+    /// @brief Queue buffer to be written after previously submitted ones
+    /// @return false if a previous write has already failed (buffer recycled)
+    bool submit(JString&& buf)
+    {
+        if (m_failed || buf.empty())
+        {
+            m_pool.recycle(std::move(buf));
+            return !m_failed;
+        }
+
+        m_gatherSize += buf.size();
+        m_gather.push_back(std::move(buf));
+        if (m_gatherSize >= m_batchBytes || m_gather.size() >= kMaxBatchBuffers)
+        {
+            commit();
+        }
+        return !m_failed;
+    }
+
+    /// @brief Queue a copy of raw bytes (copied into a pooled buffer)
+    bool submit(const char* data, size_t len)
+    {
+        JString buf = m_pool.acquire(len);
+        buf.append(data, len);
+        return submit(std::move(buf));
+    }
+
+    /// Write the gathered buffers now (asynchronously if possible).
+    void commit()
+    {
+        if (m_gather.empty()) { return; }
+        std::vector<JString> batch;
+        batch.swap(m_gather);
+        m_gatherSize = 0;
+
+        if (m_failed)
+        {
+            recycle(batch);
+            return;
+        }
+
+        if (!async())
+        {
+            write_sync(batch);
+            recycle(batch);
+            return;
+        }
+
+#if WWJSON_HAS_IO_URING
+        if (!m_seekable && m_inflight > 0)
+        {
+            m_pending.push_back(std::move(batch));
+            reap(false);
+            return;
+        }
+        while (m_freeSlots.empty() && !m_failed)
+        {
+            reap(true);
+        }
+        if (m_failed)
+        {
+            recycle(batch);
+            return;
+        }
+        start(std::move(batch));
+        reap(false);
+#endif
+    }
+
+    /// Reap finished writes without blocking.
+    void poll()
+    {
+#if WWJSON_HAS_IO_URING
+        if (m_inflight > 0) { reap(false); }
+#endif
+    }
+
+    /// Commit gathered buffers and wait until all writes are finished.
+    /// @return true if every write succeeded
+    bool drain()
+    {
+        commit();
+#if WWJSON_HAS_IO_URING
+        while (m_inflight > 0 || !m_pending.empty())
+        {
+            reap(true);
+        }
+        if (m_seekable && async())
+        {
+            // Keep fd position consistent with what was written
+            ::lseek(m_fd, static_cast<off_t>(m_offset), SEEK_SET);
+        }
+#endif
+        return !m_failed;
+    }
+
+    /// @brief Sink adapter for FlushBuffer: each flushed chunk is copied
+    /// into a pooled buffer and written asynchronously.
+    FlushSink sink()
+    {
+        return [this](const char* data, size_t len) {
+            return submit(data, len);
+        };
+    }
+
+    /// @}
+    /* ---------------------------------------------------------------------- */
+    /// @{ M2: State queries
+
+    /// Whether io_uring is in use (false: synchronous fallback).
+    bool async() const
+    {
+#if WWJSON_HAS_IO_URING
+        return m_ring.fd >= 0;
+#else
+        return false;
+#endif
+    }
+
+    /// Whether any write has failed (later submissions are dropped).
+    bool failed() const { return m_failed; }
+
+    /// errno of the first failure, 0 if none.
+    int error() const { return m_error; }
+
+    /// Number of write requests currently in flight.
+    unsigned inflight() const { return m_inflight; }
+
+    /// Total bytes written successfully.
+    uint64_t written() const { return m_written; }
+
+    /// @}
+
+private:
+    struct Slot
+    {
+        std::vector<JString> bufs;
+        std::vector<struct iovec> iov;
+        size_t total = 0;
+        size_t done = 0;
+        uint64_t offset = 0;
+    };
+
+    void fail(int err)
+    {
+        if (!m_failed)
+        {
+            m_failed = true;
+            m_error = err;
+        }
+    }
+
+    void recycle(std::vector<JString>& bufs)
+    {
+        for (auto& buf : bufs)
+        {
+            m_pool.recycle(std::move(buf));
+        }
+        bufs.clear();
+    }
+
+    /// Fill iovec array for the bytes of `bufs` after the first `skip`.
+    static void fill_iov(std::vector<struct iovec>& iov, std::vector<JString>& bufs, size_t skip)
+    {
+        iov.clear();
+        for (auto& buf : bufs)
+        {
+            if (skip >= buf.size())
+            {
+                skip -= buf.size();
+                continue;
+            }
+            struct iovec item;
+            item.iov_base = buf.begin() + skip;
+            item.iov_len = buf.size() - skip;
+            iov.push_back(item);
+            skip = 0;
+        }
+    }
+
+    void write_sync(std::vector<JString>& bufs)
+    {
+        size_t total = 0;
+        for (auto& buf : bufs) { total += buf.size(); }
+
+        std::vector<struct iovec> iov;
+        size_t done = 0;
+        while (done < total)
+        {
+            fill_iov(iov, bufs, done);
+            ssize_t n = m_seekable
+                ? ::pwritev(m_fd, iov.data(), static_cast<int>(iov.size()), static_cast<off_t>(m_offset))
+                : ::writev(m_fd, iov.data(), static_cast<int>(iov.size()));
+            if (n < 0)
+            {
+                if (errno == EINTR) { continue; }
+                fail(errno);
+                return;
+            }
+            done += static_cast<size_t>(n);
+            m_written += static_cast<uint64_t>(n);
+            if (m_seekable) { m_offset += static_cast<uint64_t>(n); }
+        }
+    }
+
+#if WWJSON_HAS_IO_URING
+    /// Minimal io_uring ring driven by raw syscalls.
+    struct Ring
+    {
+        int fd = -1;
+        void* sq_ptr = nullptr;
+        void* cq_ptr = nullptr;
+        size_t sq_size = 0;
+        size_t cq_size = 0;
+        struct io_uring_sqe* sqes = nullptr;
+        size_t sqes_size = 0;
+
+        unsigned* sq_tail = nullptr;
+        unsigned* sq_mask = nullptr;
+        unsigned* sq_array = nullptr;
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        unsigned* cq_mask = nullptr;
+        struct io_uring_cqe* cqes = nullptr;
+        unsigned to_submit = 0;
+
+        Ring() = default;
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+        ~Ring() { close(); }
+
+        bool setup(unsigned entries)
+        {
+            struct io_uring_params params;
+            ::memset(&params, 0, sizeof(params));
+            int ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (ring_fd < 0) { return false; }
+            fd = ring_fd;
+
+            sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+            bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single)
+            {
+                sq_size = cq_size = (sq_size > cq_size) ? sq_size : cq_size;
+            }
+
+            sq_ptr = ::mmap(nullptr, sq_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sq_ptr == MAP_FAILED) { sq_ptr = nullptr; close(); return false; }
+            if (single)
+            {
+                cq_ptr = sq_ptr;
+            }
+            else
+            {
+                cq_ptr = ::mmap(nullptr, cq_size, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+                if (cq_ptr == MAP_FAILED) { cq_ptr = nullptr; close(); return false; }
+            }
+
+            sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+            void* sqe_ptr = ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            if (sqe_ptr == MAP_FAILED) { close(); return false; }
+            sqes = static_cast<struct io_uring_sqe*>(sqe_ptr);
+
+            char* sq = static_cast<char*>(sq_ptr);
+            sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            char* cq = static_cast<char*>(cq_ptr);
+            cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        void close()
+        {
+            if (sqes) { ::munmap(sqes, sqes_size); sqes = nullptr; }
+            if (cq_ptr && cq_ptr != sq_ptr) { ::munmap(cq_ptr, cq_size); }
+            cq_ptr = nullptr;
+            if (sq_ptr) { ::munmap(sq_ptr, sq_size); sq_ptr = nullptr; }
+            if (fd >= 0) { ::close(fd); fd = -1; }
+        }
+
+        /// Queue a writev SQE (submitted on next enter).
+        void prep_writev(int out_fd, const struct iovec* iov, unsigned count,
+                         uint64_t offset, uint64_t user_data)
+        {
+            unsigned tail = *sq_tail;
+            unsigned index = tail & *sq_mask;
+            struct io_uring_sqe* sqe = &sqes[index];
+            ::memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_WRITEV;
+            sqe->fd = out_fd;
+            sqe->addr = reinterpret_cast<uint64_t>(iov);
+            sqe->len = count;
+            sqe->off = offset;
+            sqe->user_data = user_data;
+            sq_array[index] = index;
+            __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+            ++to_submit;
+        }
+
+        /// Submit queued SQEs, optionally waiting for one completion.
+        int enter(bool wait)
+        {
+            if (to_submit == 0 && !wait) { return 0; }
+            unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+            int ret = static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                                 wait ? 1u : 0u, flags, nullptr, 0));
+            if (ret < 0) { return -errno; }
+            unsigned submitted = static_cast<unsigned>(ret);
+            to_submit -= (submitted < to_submit) ? submitted : to_submit;
+            return ret;
+        }
+    };
+
+    /// Move batch into a free slot and queue its write.
+    void start(std::vector<JString>&& batch)
+    {
+        unsigned index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        Slot& slot = m_slots[index];
+        slot.bufs.swap(batch);
+        slot.total = 0;
+        for (auto& buf : slot.bufs) { slot.total += buf.size(); }
+        slot.done = 0;
+        if (m_seekable)
+        {
+            slot.offset = m_offset;
+            m_offset += slot.total;
+        }
+        ++m_inflight;
+        queue(index);
+    }
+
+    void queue(unsigned index)
+    {
+        Slot& slot = m_slots[index];
+        fill_iov(slot.iov, slot.bufs, slot.done);
+        uint64_t offset = m_seekable ? slot.offset + slot.done : static_cast<uint64_t>(-1);
+        m_ring.prep_writev(m_fd, slot.iov.data(), static_cast<unsigned>(slot.iov.size()),
+                           offset, index);
+    }
+
+    /// Submit queued SQEs and handle all available completions.
+    void reap(bool wait)
+    {
+        int ret = 0;
+        do
+        {
+            ret = m_ring.enter(wait && m_inflight > 0);
+        } while (ret == -EINTR);
+        if (ret < 0 && ret != -EAGAIN && ret != -EBUSY)
+        {
+            fail(-ret);
+            abandon();
+            return;
+        }
+
+        unsigned head = *m_ring.cq_head;
+        unsigned tail = __atomic_load_n(m_ring.cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail)
+        {
+            const struct io_uring_cqe& cqe = m_ring.cqes[head & *m_ring.cq_mask];
+            complete(static_cast<unsigned>(cqe.user_data), cqe.res);
+            ++head;
+        }
+        __atomic_store_n(m_ring.cq_head, head, __ATOMIC_RELEASE);
+
+        if (!m_seekable && m_inflight == 0 && !m_pending.empty())
+        {
+            if (m_failed)
+            {
+                for (auto& batch : m_pending) { recycle(batch); }
+                m_pending.clear();
+                return;
+            }
+            std::vector<JString> next = std::move(m_pending.front());
+            m_pending.pop_front();
+            start(std::move(next));
+            m_ring.enter(false);
+        }
+    }
+
+    void complete(unsigned index, int res)
+    {
+        Slot& slot = m_slots[index];
+        if (res == -EINTR || res == -EAGAIN)
+        {
+            queue(index);
+            return;
+        }
+        if (res < 0)
+        {
+            fail(-res);
+        }
+        else
+        {
+            slot.done += static_cast<size_t>(res);
+            m_written += static_cast<uint64_t>(res);
+            if (res > 0 && slot.done < slot.total && !m_failed)
+            {
+                queue(index);  // short write: continue with the rest
+                return;
+            }
+            if (slot.done < slot.total) { fail(EIO); }
+        }
+        --m_inflight;
+        recycle(slot.bufs);
+        m_freeSlots.push_back(index);
+    }
+
+    /// Ring is broken: stop waiting for in-flight writes.
+    void abandon()
+    {
+        m_inflight = 0;
+        m_pending.clear();
+        m_freeSlots.clear();
+        for (unsigned i = static_cast<unsigned>(m_slots.size()); i > 0; --i)
+        {
+            m_freeSlots.push_back(i - 1);
+        }
+    }
+#endif
+
+    int m_fd;
+    size_t m_batchBytes;
+    BufferPool m_pool;
+    std::vector<JString> m_gather;  ///< Buffers of the batch not committed yet
+    size_t m_gatherSize = 0;
+    std::vector<Slot> m_slots;
+    std::vector<unsigned> m_freeSlots;
+    unsigned m_inflight = 0;
+    bool m_seekable = false;
+    uint64_t m_offset = 0;
+    uint64_t m_written = 0;
+    bool m_failed = false;
+    int m_error = 0;
+
+#if WWJSON_HAS_IO_URING
+    Ring m_ring;
+    std::deque<std::vector<JString>> m_pending;  ///< Waiting batches for stream fd
+#endif
+};
+
+} // namespace wwjson
+
+#endif // JURING_HPP__
@@ -0,0 +1,337 @@
+/**
+ * @file jvalid.hpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @version 1.0.0
+ *
+ * @brief Allocation-free JSON validator
+ *
+ * @details Raw fragments given to PutSub/AddItemSub/AddMemberSub are copied
+ * as they are, the caller being responsible for their validity. This header
+ * checks a text against the JSON grammar (RFC 8259) without building
+ * anything: strings are crossed eight bytes at a time until a quote, escape,
+ * control or non-ASCII byte, escapes and UTF-8 sequences are checked in
+ * place, numbers and literals by their exact grammar, and the open
+ * containers are kept as one bit each in a fixed array on the stack.
+ *
+ * It backs three uses:
+ * - `WWJSON_VALIDATE_SUB=1` asserts every PutSub fragment in debug builds;
+ * - `configT::kValidateSub` writes `null` in place of an invalid fragment;
+ * - validate_json()/is_json_valid() for tests and checks of any output.
+ *
+ * @par Usage Example:
+ * ```cpp
+ * if (!wwjson::is_json_valid(fragment)) { ... }
+ * size_t at = wwjson::validate_json(text);   // npos if valid
+ * ```
+ *
+ * @note Nesting deeper than WWJSON_VALID_MAX_DEPTH (1024 by default) is
+ * reported invalid.
+ */
+
+#pragma once
+#ifndef JVALID_HPP__
+#define JVALID_HPP__
+
+// Branch prediction macros, as in wwjson.hpp
+#ifndef wwjson_likely
+#if defined(__GNUC__) || defined(__clang__)
+#define wwjson_likely(x) __builtin_expect(!!(x), 1)
+#define wwjson_unlikely(x) __builtin_expect(!!(x), 0)
+#else
+#define wwjson_likely(x) (x)
+#define wwjson_unlikely(x) (x)
+#endif
+#endif
+
+#include <string_view>
+
+#include <stdint.h>
+#include <string.h>
+
+/// Maximum nesting of arrays and objects accepted by validate_json().
+#ifndef WWJSON_VALID_MAX_DEPTH
+#define WWJSON_VALID_MAX_DEPTH 1024
+#endif
+
+namespace wwjson {
+
+namespace detail {
+
+/// @brief High bit mask of the bytes `"`, `\`, below 0x20 or above 0x7F
+/// @details Bytes above the first one found may be flagged falsely, the
+/// lowest flagged byte is exact.
+inline uint64_t string_special_mask(uint64_t word)
+{
+    constexpr uint64_t kOnes = 0x0101010101010101ULL;
+    constexpr uint64_t kHighs = 0x8080808080808080ULL;
+    uint64_t quote = word ^ (kOnes * '"');
+    uint64_t escape = word ^ (kOnes * '\\');
+    uint64_t control = (word - kOnes * 0x20) & ~word;
+    return (((quote - kOnes) & ~quote) | ((escape - kOnes) & ~escape) | control | word) & kHighs;
+}
+
+/// Offset of the first flagged byte of a non-zero mask loaded by memcpy,
+/// or 0 where the byte order is not known to be little endian.
+inline size_t first_flagged_byte(uint64_t mask)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__BYTE_ORDER__) \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return static_cast<size_t>(__builtin_ctzll(mask)) / 8;
+#else
+    (void)mask;
+    return 0;
+#endif
+}
+
+/// Length of the UTF-8 sequence at p, 0 if ill-formed (overlong,
+/// surrogate, above U+10FFFF or truncated).
+inline size_t valid_utf8(const unsigned char* p, const unsigned char* end)
+{
+    unsigned char c = p[0];
+    size_t len = 0;
+    unsigned char lo = 0x80;
+    unsigned char hi = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) { len = 2; }
+    else if (c >= 0xE0 && c <= 0xEF)
+    {
+        len = 3;
+        if (c == 0xE0) { lo = 0xA0; }
+        else if (c == 0xED) { hi = 0x9F; }
+    }
+    else if (c >= 0xF0 && c <= 0xF4)
+    {
+        len = 4;
+        if (c == 0xF0) { lo = 0x90; }
+        else if (c == 0xF4) { hi = 0x8F; }
+    }
+    else { return 0; }
+
+    if (static_cast<size_t>(end - p) < len) { return 0; }
+    if (p[1] < lo || p[1] > hi) { return 0; }
+    for (size_t i = 2; i < len; ++i)
+    {
+        if ((p[i] & 0xC0) != 0x80) { return 0; }
+    }
+    return len;
+}
+
+inline bool is_hex_digit(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/// @brief Check a string body
+/// @param p Just after the opening quote
+/// @return Just after the closing quote, nullptr if invalid
+inline const char* valid_string(const char* p, const char* end)
+{
+    for (;;)
+    {
+        while (end - p >= 8)
+        {
+            uint64_t word;
+            ::memcpy(&word, p, 8);
+            uint64_t mask = string_special_mask(word);
+            if (mask != 0)
+            {
+                p += first_flagged_byte(mask);
+                break;
+            }
+            p += 8;
+        }
+        if (wwjson_unlikely(p >= end)) { return nullptr; }
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"') { return p + 1; }
+        if (c == '\\')
+        {
+            if (end - p < 2) { return nullptr; }
+            switch (p[1])
+            {
+            case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                p += 2;
+                break;
+            case 'u':
+                if (end - p < 6 || !is_hex_digit(p[2]) || !is_hex_digit(p[3])
+                    || !is_hex_digit(p[4]) || !is_hex_digit(p[5]))
+                {
+                    return nullptr;
+                }
+                p += 6;
+                break;
+            default:
+                return nullptr;
+            }
+        }
+        else if (c < 0x20) { return nullptr; }
+        else if (c < 0x80) { ++p; }
+        else
+        {
+            size_t len = valid_utf8(reinterpret_cast<const unsigned char*>(p),
+                                    reinterpret_cast<const unsigned char*>(end));
+            if (len == 0) { return nullptr; }
+            p += len;
+        }
+    }
+}
+
+inline const char* valid_digits(const char* p, const char* end)
+{
+    const char* start = p;
+    while (p < end && *p >= '0' && *p <= '9') { ++p; }
+    return p > start ? p : nullptr;
+}
+
+/// @brief Check a number, `-?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?`
+/// @return Just after the number, nullptr if invalid
+inline const char* valid_number(const char* p, const char* end)
+{
+    if (*p == '-') { ++p; }
+    if (p >= end) { return nullptr; }
+    if (*p == '0') { ++p; }
+    else if ((p = valid_digits(p, end)) == nullptr) { return nullptr; }
+    if (p < end && *p == '.')
+    {
+        if ((p = valid_digits(p + 1, end)) == nullptr) { return nullptr; }
+    }
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        if (p < end && (*p == '+' || *p == '-')) { ++p; }
+        if ((p = valid_digits(p, end)) == nullptr) { return nullptr; }
+    }
+    return p;
+}
+
+inline const char* valid_literal(const char* p, const char* end, const char* word, size_t len)
+{
+    if (static_cast<size_t>(end - p) < len || ::memcmp(p, word, len) != 0) { return nullptr; }
+    return p + len;
+}
+
+inline const char* valid_ws(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) { ++p; }
+    return p;
+}
+
+/// @brief Check an object key and its colon
+/// @return At the member value, nullptr if invalid
+inline const char* valid_key(const char* p, const char* end)
+{
+    if (p >= end || *p != '"') { return nullptr; }
+    p = valid_string(p + 1, end);
+    if (p == nullptr) { return nullptr; }
+    p = valid_ws(p, end);
+    if (p >= end || *p != ':') { return nullptr; }
+    return valid_ws(p + 1, end);
+}
+
+} // namespace detail
+
+/// @brief Check a text against the JSON grammar
+/// @param json One JSON value, with optional surrounding whitespace
+/// @return std::string_view::npos if valid, otherwise the offset of the
+/// value or token where the text stops being valid JSON
+inline size_t validate_json(std::string_view json)
+{
+    constexpr size_t kWords = (WWJSON_VALID_MAX_DEPTH + 63) / 64;
+    uint64_t objects[kWords];  // bit per open container, 1 for an object
+    size_t depth = 0;
+
+    const char* begin = json.data();
+    const char* end = begin + json.size();
+    const char* p = detail::valid_ws(begin, end);
+    auto fail = [begin](const char* at) { return static_cast<size_t>(at - begin); };
+
+    for (;;)
+    {
+        // a value
+        if (wwjson_unlikely(p >= end)) { return fail(p); }
+        const char* q = nullptr;
+        switch (*p)
+        {
+        case '{':
+        case '[':
+        {
+            if (wwjson_unlikely(depth >= kWords * 64)) { return fail(p); }
+            bool object = (*p == '{');
+            uint64_t bit = uint64_t(1) << (depth % 64);
+            if (object) { objects[depth / 64] |= bit; }
+            else { objects[depth / 64] &= ~bit; }
+            ++depth;
+            p = detail::valid_ws(p + 1, end);
+            if (p < end && *p == (object ? '}' : ']'))
+            {
+                --depth;
+                q = p + 1;
+                break;
+            }
+            if (object)
+            {
+                q = detail::valid_key(p, end);
+                if (q == nullptr) { return fail(p); }
+            }
+            else
+            {
+                q = p;
+            }
+            p = q;
+            continue;
+        }
+        case '"':
+            q = detail::valid_string(p + 1, end);
+            break;
+        case 't':
+            q = detail::valid_literal(p, end, "true", 4);
+            break;
+        case 'f':
+            q = detail::valid_literal(p, end, "false", 5);
+            break;
+        case 'n':
+            q = detail::valid_literal(p, end, "null", 4);
+            break;
+        default:
+            if (*p == '-' || (*p >= '0' && *p <= '9')) { q = detail::valid_number(p, end); }
+            break;
+        }
+        if (q == nullptr) { return fail(p); }
+        p = q;
+
+        // separators and closers after the value
+        for (;;)
+        {
+            p = detail::valid_ws(p, end);
+            if (depth == 0)
+            {
+                return p == end ? std::string_view::npos : fail(p);
+            }
+            if (p >= end) { return fail(p); }
+            bool object = (objects[(depth - 1) / 64] >> ((depth - 1) % 64)) & 1;
+            if (*p == ',')
+            {
+                p = detail::valid_ws(p + 1, end);
+                if (object)
+                {
+                    q = detail::valid_key(p, end);
+                    if (q == nullptr) { return fail(p); }
+                    p = q;
+                }
+                break;
+            }
+            if (*p != (object ? '}' : ']')) { return fail(p); }
+            --depth;
+            ++p;
+        }
+    }
+}
+
+/// @brief True if the text is one valid JSON value
+inline bool is_json_valid(std::string_view json)
+{
+    return validate_json(json) == std::string_view::npos;
+}
+
+} // namespace wwjson
+
+#endif // JVALID_HPP__
@@ -31,6 +31,7 @@
 #endif
 
 #include <array>
+#include <cassert>
 #include <charconv>
 #include <cmath>
 #include <memory>
@@ -41,6 +42,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "jvalid.hpp"
+
 /// High precision floating-point serialization control.
 /// Define this macro to use simple %g format (shorter but less precise).
 /// Default is high precision %.17g for better accuracy.
@@ -50,6 +53,12 @@
 #define WWJSON_USE_SIMPLE_FLOAT_FORMAT 0
 #endif
 
+/// Define this macro to 1 to assert that every PutSub fragment is valid JSON.
+/// Meant for debug builds, the assert is gone with NDEBUG.
+#ifndef WWJSON_VALIDATE_SUB
+#define WWJSON_VALIDATE_SUB 0
+#endif
+
 namespace wwjson
 {
 
@@ -536,6 +545,7 @@ template <typename stringT> struct NumberWriter
 /// - **kEscapeValue**: Controls automatic escaping of string values  
 /// - **kQuoteNumber**: Controls whether numeric values are quoted as strings
 /// - **kTailComma**: Controls generation of trailing commas in arrays/objects
+/// - **kValidateSub**: Controls validation of raw fragments given to PutSub
 ///
 /// @note All options are evaluated at compile-time using constexpr, ensuring
 /// zero runtime overhead for configuration decisions.
@@ -591,6 +601,16 @@ template <typename stringT> struct BasicConfig
     /// can improve performance by avoiding comma removal logic.
     static constexpr bool kTailComma = false;
 
+    /// @brief Validate raw JSON fragments written by PutSub
+    /// @details
+    /// When true, PutSub (and AddItemSub/AddMemberSub) checks each fragment
+    /// with is_json_valid() and writes `null` instead of an invalid one, so
+    /// that a bad upstream fragment cannot corrupt the whole document.
+    ///
+    /// @note Default is false - the caller is responsible for the fragments,
+    /// and the check costs one extra pass over each of them.
+    static constexpr bool kValidateSub = false;
+
     /// @brief Compile-time escape table for ASCII character processing
     /// @details
     /// Static constexpr table mapping ASCII characters (0-127) to their escape
@@ -729,6 +749,53 @@ template <typename stringT> struct BasicConfig
     }
 };
 
+/// @brief Deferred member value, computed only when the member is written
+/// @details
+/// Created by lazy(). Unlike a callable passed to AddItem(), which writes to
+/// the builder itself, the callable here returns the value to be written,
+/// of any type that AddItem() accepts. With a field index, the member is
+/// dropped as a whole (key and computation) when the builder's field mask
+/// has that bit cleared, see GenericBuilder::SetFieldMask().
+template <typename Func> struct LazyValue
+{
+    Func func;       ///< Callable with no parameters returning the value
+    int field = -1;  ///< Bit of the builder field mask, -1 for always written
+};
+
+/// @brief Wrap a callable returning a value as a deferred member value
+/// @code
+/// builder.AddMember("stats", wwjson::lazy([&]() { return ComputeStats(); }));
+/// @endcode
+template <typename Func>
+LazyValue<std::decay_t<Func>> lazy(Func &&func)
+{
+    return LazyValue<std::decay_t<Func>>{std::forward<Func>(func), -1};
+}
+
+/// @brief Wrap a deferred member value gated by bit `field` of the field mask
+/// @code
+/// enum { kFieldStats = 3 };
+/// builder.SetFieldMask(request_mask);
+/// builder.AddMember("stats", wwjson::lazy(kFieldStats, [&]() { return ComputeStats(); }));
+/// @endcode
+template <typename Func>
+LazyValue<std::decay_t<Func>> lazy(int field, Func &&func)
+{
+    return LazyValue<std::decay_t<Func>>{std::forward<Func>(func), field};
+}
+
+namespace detail
+{
+/// Type trait to detect a single LazyValue argument.
+template <typename T> struct is_lazy : std::false_type { };
+template <typename Func> struct is_lazy<LazyValue<Func>> : std::true_type { };
+
+template <typename... Args>
+inline constexpr bool is_lazy_v = false;
+template <typename T>
+inline constexpr bool is_lazy_v<T> = is_lazy<std::decay_t<T>>::value;
+} // namespace detail
+
 /// @brief Main JSON builder for constructing JSON strings without DOM trees
 /// @details
 /// GenericBuilder provides a high-performance interface for constructing JSON
@@ -759,9 +826,11 @@ template <typename stringT, typename configT = BasicConfig<stringT>>
 struct GenericBuilder
 {
     stringT json; ///< Internal string buffer storing the JSON being constructed
+    uint64_t field_mask = ~uint64_t(0); ///< Enabled lazy fields, see SetFieldMask()
 
     using string_type = stringT; ///< Type alias for the underlying string type
     using builder_type = GenericBuilder<stringT, configT>; ///< Type alias for this builder
+    using config_type = configT; ///< Type alias for the configuration type
 
     /// @{ M0: Basic construction and lifecycle methods
 
@@ -823,6 +892,16 @@ struct GenericBuilder
         return json;
     }
 
+    /// @brief Check the JSON built so far is one complete valid value
+    /// @details A trailing comma left by the last item is ignored, as by
+    /// GetResult(). Meant for tests and debug checks of the output.
+    bool IsValid() const
+    {
+        std::string_view text(json.data(), json.size());
+        if (!text.empty() && text.back() == ',') { text.remove_suffix(1); }
+        return is_json_valid(text);
+    }
+
     /// @brief Move the JSON string result to transfer ownership
     /// @return rvalue reference to the built JSON string
     /// @note This is the recommended way to extract the final result
@@ -860,11 +939,25 @@ struct GenericBuilder
         }
     }
 
+    /// @brief Replace the tail char if it is `expected`, otherwise append
+    /// @note For string types with a small unsafe margin, the replacement is
+    /// written by a safe push, so that the margin holds for the following
+    /// SepItem() even after many closing brackets in a row. This costs one
+    /// capacity check per EndObject()/EndArray() of such builders.
     void FixTail(char expected, char replacement)
     {
         if (wwjson_likely(!json.empty() && json.back() == expected))
         {
-            json.back() = replacement;
+            constexpr uint8_t level = detail::unsafe_level_v<stringT>;
+            if constexpr (level >= 4 && level < 0xFF)
+            {
+                json.pop_back();
+                json.push_back(replacement);
+            }
+            else
+            {
+                json.back() = replacement;
+            }
         }
         else
         {
@@ -1144,10 +1237,22 @@ struct GenericBuilder
     }
 
     /// Append JSON sub-string (raw JSON content) without quotes or escaping.
-    /// User is responsible for ensuring the input is valid JSON.
+    /// User is responsible for ensuring the input is valid JSON, unless
+    /// configT::kValidateSub is set, see also WWJSON_VALIDATE_SUB.
     void PutSub(const char *pszSub, size_t len)
     {
         if (wwjson_unlikely(pszSub == nullptr)) { return; }
+#if WWJSON_VALIDATE_SUB
+        assert(is_json_valid(std::string_view(pszSub, len)) && "PutSub fragment is not valid JSON");
+#endif
+        if constexpr (configT::kValidateSub)
+        {
+            if (wwjson_unlikely(!is_json_valid(std::string_view(pszSub, len))))
+            {
+                Append("null", 4);
+                return;
+            }
+        }
         Append(pszSub, len);
     }
 
@@ -1171,6 +1276,21 @@ struct GenericBuilder
     /* ---------------------------------------------------------------------- */
     /// @{ M4: JSON Array and Object Element Methods
 
+    /// @brief Select the lazy fields to write by a bit mask
+    /// @details Bit i enables members added with `lazy(i, func)`; a member
+    /// whose bit is cleared writes neither key nor value, and func is not
+    /// called. Lazy values without field index, and field indexes out of
+    /// 0..63, are always written. The default mask enables all fields.
+    void SetFieldMask(uint64_t mask) { field_mask = mask; }
+    uint64_t GetFieldMask() const { return field_mask; }
+
+    /// Check if the lazy field of index `field` is enabled by the mask.
+    bool HasField(int field) const
+    {
+        if (field < 0 || field >= 64) { return true; }
+        return (field_mask >> field) & 1;
+    }
+
     /// Add numeric item to array.
     template <typename numberT>
     std::enable_if_t<std::is_arithmetic_v<numberT>, void> AddItem(numberT value)
@@ -1203,8 +1323,22 @@ struct GenericBuilder
     /// Add string(or other supported type of) item to array.
     template <typename... Args> void AddItem(Args &&... args)
     {
-        PutValue(std::forward<Args>(args)...);
-        SepItem();
+        if constexpr (detail::is_lazy_v<Args...>)
+        {
+            AddItem(static_cast<const std::decay_t<Args> &>(args)...);
+        }
+        else
+        {
+            PutValue(std::forward<Args>(args)...);
+            SepItem();
+        }
+    }
+
+    /// Add item to array with deferred value, computed now by calling it.
+    /// The field mask only applies to members, see AddMember().
+    template <typename Func> void AddItem(const LazyValue<Func> &value)
+    {
+        AddItem(value.func());
     }
 
     /// Add item to array using callable function with GenericBuilder reference
@@ -1252,6 +1386,7 @@ struct GenericBuilder
     /// - Boolean values (true/false)
     /// - Null values (nullptr)
     /// - Callable functions for nested structures
+    /// - Deferred values by lazy(), skipped with the key if masked out
     ///
     /// @par Usage Examples:
     /// @code
@@ -1272,6 +1407,10 @@ struct GenericBuilder
     template <typename keyT, typename... Args>
     std::enable_if_t<detail::is_key_v<keyT>, void> AddMember(keyT &&key, Args &&... args)
     {
+        if constexpr (detail::is_lazy_v<Args...>)
+        {
+            if (!HasField(args.field...)) { return; }
+        }
         PutKey(std::forward<keyT>(key));
         AddItem(std::forward<Args>(args)...);
     }
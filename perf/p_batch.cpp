@@ -0,0 +1,89 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jbatch.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace test::perf
+{
+
+/**
+ * @brief 多个小文档打包进一个缓冲区与每条消息新建 Builder 对比
+ * 每批 items 条小消息（约 60 字节），如发布订阅的扇出。
+ * 方法A: BatchBuilder 连续写入同一缓冲区，批间复用内存
+ * 方法B: 每条消息新建 Builder，结果移出为 JString
+ */
+class BatchVsSingleTest : public RelativeTimer<BatchVsSingleTest>
+{
+  public:
+    int items;
+    wwjson::BatchBuilder batch;
+    std::vector<wwjson::JString> singles;
+
+    explicit BatchVsSingleTest(int n) : items(n), batch(n * 64)
+    {
+        singles.reserve(n);
+    }
+
+    template <typename builderT>
+    static void Message(builderT& builder, int i)
+    {
+        builder.BeginObject();
+        builder.AddMember("topic", "prices");
+        builder.AddMember("seq", i);
+        builder.AddMember("value", i * 3 + 1);
+        builder.AddMember("ok", i % 2 == 0);
+        builder.EndObject();
+    }
+
+    void methodA()
+    {
+        batch.Clear();
+        for (int i = 0; i < items; ++i)
+        {
+            Message(batch.Begin(), i);
+            batch.Commit();
+        }
+    }
+
+    void methodB()
+    {
+        singles.clear();
+        for (int i = 0; i < items; ++i)
+        {
+            wwjson::Builder builder(128);
+            Message(builder, i);
+            singles.push_back(builder.MoveResult());
+        }
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        if (batch.size() != singles.size()) { return false; }
+        for (size_t i = 0; i < singles.size(); ++i)
+        {
+            if (batch[i] != std::string_view(singles[i].data(), singles[i].size())) { return false; }
+        }
+        return true;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(batch_vs_single, "BatchBuilder 批量打包 vs 每条消息新建 Builder")
+{
+    test::CArgv argv;
+    DESC("Args: --items=%d --loop=%d", argv.items, argv.loop);
+
+    test::perf::BatchVsSingleTest tester(argv.items);
+    double ratio = tester.runAndPrint("Batch vs Single", "BatchBuilder",
+                                      "Builder per message", argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
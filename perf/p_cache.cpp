@@ -0,0 +1,214 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jcache.hpp"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace test::perf
+{
+
+/// Key names of the constant settings object.
+inline const std::vector<std::string>& OptionKeys()
+{
+    static const std::vector<std::string> keys = [] {
+        std::vector<std::string> names;
+        for (int i = 0; i < 30; ++i) { names.push_back("option_" + std::to_string(i)); }
+        return names;
+    }();
+    return keys;
+}
+
+/// Response with a large constant part and three changing values.
+template <typename idT, typename nameT, typename costT>
+void BuildResponse(wwjson::Builder& builder, const idT& id, const nameT& name, const costT& cost)
+{
+    builder.BeginObject();
+    builder.AddMember("status", "success");
+    builder.AddMember("request_id", id);
+    builder.BeginObject("settings");
+    const auto& keys = OptionKeys();
+    for (int i = 0; i < 30; ++i) { builder.AddMember(keys[i], i * 3); }
+    builder.EndObject();
+    builder.BeginArray("regions");
+    for (int i = 0; i < 10; ++i)
+    {
+        builder.BeginObject();
+        builder.AddMember("code", i);
+        builder.AddMember("name", "region");
+        builder.AddMember("weight", i * 0.25);
+        builder.EndObject();
+    }
+    builder.EndArray();
+    builder.AddMember("user", name);
+    builder.AddMember("cost", cost);
+    builder.EndObject();
+}
+
+/**
+ * @brief 结构不变的响应重复渲染：RenderCache 与每次完整构建对比
+ * 方法A: RenderCache 记录一次，之后只拷贝字面片段并写入 3 个变化值
+ * 方法B: 每次用 Builder 完整构建
+ */
+class CacheVsBuilderTest : public RelativeTimer<CacheVsBuilderTest>
+{
+  public:
+    wwjson::RenderCache cache;
+    int items;
+    std::string resultA;
+    std::string resultB;
+
+    explicit CacheVsBuilderTest(int n) : items(n)
+    {
+        auto slot = wwjson::RenderCache::Slot();
+        cache.Record([&](wwjson::Builder& b) { BuildResponse(b, slot, slot, slot); });
+    }
+
+    void methodA()
+    {
+        for (int i = 0; i < items; ++i)
+        {
+            resultA = cache.Render(i, "guest", i * 0.5);
+        }
+    }
+
+    void methodB()
+    {
+        for (int i = 0; i < items; ++i)
+        {
+            wwjson::Builder builder;
+            BuildResponse(builder, i, "guest", i * 0.5);
+            resultB = builder.MoveResult().str();
+        }
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return !resultA.empty() && resultA == resultB;
+    }
+};
+
+/// Author object of about 2 KB of JSON.
+struct Author
+{
+    int id = 0;
+    std::string name;
+    std::string bio;
+    std::vector<std::string> links;
+    std::vector<int> badges;
+
+    void to_json(wwjson::Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(name);
+        TO_JSON(bio);
+        TO_JSON(links);
+        TO_JSON(badges);
+    }
+};
+
+/**
+ * @brief 动态流响应：同一作者对象在一个响应中出现多次
+ * 每个响应 items 条帖子，作者从 8 个共享对象中轮流引用，每个约 2KB。
+ * 方法A: MemoCache 命中时直接拼接已序列化片段
+ * 方法B: 每次重新序列化作者对象
+ */
+class MemoVsPlainTest : public RelativeTimer<MemoVsPlainTest>
+{
+  public:
+    std::vector<std::shared_ptr<Author>> authors;
+    wwjson::MemoCache memo;
+    int items;
+    std::string resultA;
+    std::string resultB;
+
+    explicit MemoVsPlainTest(int n) : items(n)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            auto author = std::make_shared<Author>();
+            author->id = i;
+            author->name = "author_" + std::to_string(i);
+            author->bio = std::string(1200, 'b');
+            for (int k = 0; k < 10; ++k)
+            {
+                author->links.push_back("https://example.com/author/" + std::to_string(i) + "/" + std::to_string(k));
+            }
+            for (int k = 0; k < 40; ++k) { author->badges.push_back(k * 37 + i); }
+            authors.push_back(std::move(author));
+        }
+    }
+
+    template <typename authorT>
+    std::string Build(authorT&& put_author)
+    {
+        wwjson::Builder builder;
+        builder.BeginArray();
+        for (int i = 0; i < items; ++i)
+        {
+            builder.BeginObject();
+            builder.AddMember("post", i);
+            builder.AddMember("title", "hello");
+            put_author(builder, authors[i % authors.size()]);
+            builder.EndObject();
+        }
+        builder.EndArray();
+        return builder.MoveResult().str();
+    }
+
+    void methodA()
+    {
+        resultA = Build([this](wwjson::Builder& b, const std::shared_ptr<Author>& author) {
+            memo.to_json(b, "author", author);
+        });
+    }
+
+    void methodB()
+    {
+        resultB = Build([](wwjson::Builder& b, const std::shared_ptr<Author>& author) {
+            wwjson::to_json(b, "author", *author);
+        });
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return !resultA.empty() && resultA == resultB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(cache_vs_builder, "RenderCache 重复渲染 vs Builder 完整构建")
+{
+    test::CArgv argv;
+    int loop = argv.loop / 10;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --items=%d --loop=%d (x1/10)", argv.items, argv.loop);
+
+    test::perf::CacheVsBuilderTest tester(argv.items);
+    double ratio = tester.runAndPrint("RenderCache vs Builder", "RenderCache",
+                                      "Builder", loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
+
+DEF_TAST(cache_memo_vs_plain, "MemoCache 共享对象片段记忆 vs 每次重新序列化")
+{
+    test::CArgv argv;
+    int loop = argv.loop / 10;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --items=%d --loop=%d (x1/10)", argv.items, argv.loop);
+
+    test::perf::MemoVsPlainTest tester(argv.items);
+    double ratio = tester.runAndPrint("MemoCache vs Plain", "MemoCache",
+                                      "to_json", loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
@@ -0,0 +1,143 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jconcurrent.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test::perf
+{
+
+/// Split output into sorted lines, to compare unordered producer output.
+static std::vector<std::string> SortLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream is(text);
+    std::string line;
+    while (std::getline(is, line)) { lines.push_back(line); }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+}
+
+/**
+ * @brief 多生产者线程写同一输出缓冲：无锁预留与加锁追加对比
+ * 每个生产者线程构建 items 行小 json 文档（每个一行）。
+ * 方法A: ConcurrentBuffer 原子预留后直接在预留区构建，消费者线程刷新
+ * 方法B: Builder 构建后加互斥锁追加到共享 std::string
+ */
+class ConcurrentAppendTest : public RelativeTimer<ConcurrentAppendTest>
+{
+  public:
+    int items;
+    int threads;
+    std::string outputA;
+    std::string outputB;
+    std::mutex mutex;
+
+    ConcurrentAppendTest(int n, int t) : items(n), threads(t) {}
+
+    template <typename builderT>
+    static void buildLine(builderT& builder, int producer, int id)
+    {
+        builder.BeginObject();
+        builder.AddMember("producer", producer);
+        builder.AddMember("id", id);
+        builder.AddMember("name", "concurrent_benchmark");
+        builder.AddMember("score", id * 0.125);
+        builder.EndObject();
+        builder.GetResult();
+        builder.PutChar('\n');
+    }
+
+    void methodA()
+    {
+        outputA.clear();
+        wwjson::ConcurrentBuffer shared([this](const char* data, size_t len) {
+            outputA.append(data, len);
+            return true;
+        });
+        std::atomic<int> running{threads};
+        std::thread consumer([&] {
+            while (running.load() > 0)
+            {
+                if (shared.flush() == 0) { std::this_thread::yield(); }
+            }
+        });
+        std::vector<std::thread> producers;
+        for (int p = 0; p < threads; ++p)
+        {
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < items; ++i)
+                {
+                    auto slot = shared.reserve(256);
+                    while (!slot)
+                    {
+                        std::this_thread::yield();
+                        slot = shared.reserve(256);
+                    }
+                    wwjson::SlotBuilder builder(slot.view(), 0);
+                    buildLine(builder, p, i);
+                    slot.commit(builder);
+                }
+                --running;
+            });
+        }
+        for (auto& t : producers) { t.join(); }
+        consumer.join();
+        shared.finish();
+    }
+
+    void methodB()
+    {
+        outputB.clear();
+        std::vector<std::thread> producers;
+        for (int p = 0; p < threads; ++p)
+        {
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < items; ++i)
+                {
+                    wwjson::Builder builder(256);
+                    buildLine(builder, p, i);
+                    auto& json = builder.json;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    outputB.append(json.data(), json.size());
+                }
+            });
+        }
+        for (auto& t : producers) { t.join(); }
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return !outputA.empty() && SortLines(outputA) == SortLines(outputB);
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(concurrent_vs_mutex, "ConcurrentBuffer 无锁预留与互斥锁追加对比")
+{
+    test::CArgv argv;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 2) { threads = 2; }
+    BIND_ARGV(threads);
+    // each loop runs all producers, scale down the default
+    int loop = argv.loop / 100;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --items=%d --threads=%d --loop=%d (x1/100)", argv.items, threads, argv.loop);
+
+    test::perf::ConcurrentAppendTest tester(argv.items, threads);
+    double ratio = tester.runAndPrint("Concurrent Append", "ConcurrentBuffer",
+                                      "mutex append", loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
@@ -0,0 +1,89 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jcount.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace test::perf
+{
+
+/**
+ * @brief 两遍精确分配与扩容增长对比：大字符串数组
+ * 数组含 items 个长度为 length 的字符串，内容为主，记号少，计数一遍代价低。
+ * 方法A: to_json_exact，先计数再一次分配 FastBuilder
+ * 方法B: builderT 默认初始容量，按需扩容（Builder 用 realloc，RawBuilder 复制）
+ */
+template <typename builderT>
+class ExactVsGrowthTest : public RelativeTimer<ExactVsGrowthTest<builderT>>
+{
+  public:
+    std::vector<std::string> doc;
+    wwjson::JString resultA;
+    typename builderT::string_type resultB;
+
+    ExactVsGrowthTest(int items, int length)
+    {
+        doc.reserve(items);
+        for (int i = 0; i < items; ++i)
+        {
+            doc.emplace_back(static_cast<size_t>(length), static_cast<char>('a' + i % 26));
+        }
+    }
+
+    void methodA()
+    {
+        resultA = wwjson::to_json_exact<wwjson::JString>(doc);
+    }
+
+    void methodB()
+    {
+        builderT builder;
+        wwjson::to_json(builder, doc);
+        resultB = builder.MoveResult();
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA.size() > 0 && resultA.str() == std::string(resultB.data(), resultB.size());
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(count_exact_vs_growth, "to_json_exact 两遍精确分配 vs Builder 扩容增长（大字符串）")
+{
+    test::CArgv argv;
+    int length = 4096;
+    BIND_ARGV(length);
+    // each loop writes items * length bytes, scale down the default
+    int loop = argv.loop / 10;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --items=%d --length=%d --loop=%d (x1/10)", argv.items, length, argv.loop);
+
+    test::perf::ExactVsGrowthTest<wwjson::Builder> tester(argv.items, length);
+    double ratio = tester.runAndPrint("Exact vs Growth", "to_json_exact",
+                                      "Builder growth", loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
+
+DEF_TAST(count_exact_vs_string, "to_json_exact 两遍精确分配 vs std::string 扩容增长（大字符串）")
+{
+    test::CArgv argv;
+    int length = 4096;
+    BIND_ARGV(length);
+    int loop = argv.loop / 10;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --items=%d --length=%d --loop=%d (x1/10)", argv.items, length, argv.loop);
+
+    test::perf::ExactVsGrowthTest<wwjson::RawBuilder> tester(argv.items, length);
+    double ratio = tester.runAndPrint("Exact vs std::string Growth", "to_json_exact",
+                                      "RawBuilder growth", loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
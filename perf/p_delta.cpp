@@ -0,0 +1,100 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jdelta.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace test::perf
+{
+
+struct Book
+{
+    std::vector<double> bids;
+    std::vector<double> asks;
+};
+WWJSON_FIELDS(Book, bids, asks)
+
+struct MarketState
+{
+    int64_t seq = 0;
+    std::string symbol = "WWJSON";
+    double last = 100.0;
+    int64_t volume = 0;
+    std::string status = "trading";
+    Book book;
+    std::vector<std::string> notes;
+};
+WWJSON_FIELDS(MarketState, seq, symbol, last, volume, status, book, notes)
+
+/**
+ * @brief 增量重新序列化与完整序列化对比：大状态对象每次只变少数字段
+ * 状态含 items 档买卖盘与 items 条备注，每次发布只改 seq、last 与 volume。
+ * 方法A: DeltaJson 只序列化三个脏字段，等宽原位修补，变宽重新拼接
+ * 方法B: wwjson::to_json 每次完整序列化
+ */
+class DeltaVsFullTest : public RelativeTimer<DeltaVsFullTest>
+{
+  public:
+    MarketState state;
+    wwjson::DeltaJson<MarketState> delta;
+    std::string resultA;
+    std::string resultB;
+
+    explicit DeltaVsFullTest(int items)
+    {
+        for (int i = 0; i < items; ++i)
+        {
+            state.book.bids.push_back(100.0 - i * 0.25);
+            state.book.asks.push_back(100.0 + i * 0.25);
+            state.notes.push_back("note number " + std::to_string(i));
+        }
+        delta.Build(state);
+    }
+
+    /// One publish tick: a few fields change.
+    void Tick()
+    {
+        ++state.seq;
+        state.last = 100.0 + (state.seq % 8) * 0.125;
+        state.volume += 100;
+    }
+
+    void methodA()
+    {
+        Tick();
+        delta.MarkDirty(&MarketState::seq);
+        delta.MarkDirty(&MarketState::last);
+        delta.MarkDirty(&MarketState::volume);
+        resultA = delta.Update(state);
+    }
+
+    void methodB()
+    {
+        Tick();
+        resultB = wwjson::to_json(state);
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        return resultA == wwjson::to_json(state);
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(delta_vs_full, "DeltaJson 增量修补脏字段 vs 每次完整序列化")
+{
+    test::CArgv argv;
+    DESC("Args: --items=%d --loop=%d", argv.items, argv.loop);
+
+    test::perf::DeltaVsFullTest tester(argv.items);
+    double ratio = tester.runAndPrint("Delta vs Full", "DeltaJson",
+                                      "to_json", argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
@@ -0,0 +1,128 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jlogger.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test::perf
+{
+
+/**
+ * @brief 多线程结构化日志吞吐：Logger 与 Builder + 互斥锁 + fwrite 对比
+ * 每个线程写 items 行 json 日志到 /dev/null。
+ * 方法A: Logger，线程本地缓冲，后台线程批量 writev
+ * 方法B: 每行构建一个 Builder，加锁后 fwrite 到共享 FILE*
+ */
+class LoggerThroughputTest : public RelativeTimer<LoggerThroughputTest>
+{
+  public:
+    int items;
+    int threads;
+    FILE* devnull = nullptr;
+    std::mutex mutex;
+    size_t linesA = 0;
+    size_t linesB = 0;
+
+    LoggerThroughputTest(int n, int t) : items(n), threads(t)
+    {
+        devnull = std::fopen("/dev/null", "w");
+    }
+
+    ~LoggerThroughputTest()
+    {
+        if (devnull) { std::fclose(devnull); }
+    }
+
+    template <typename bodyT>
+    void runThreads(bodyT&& body)
+    {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&body, t] { body(t); });
+        }
+        for (auto& w : workers) { w.join(); }
+    }
+
+    void methodA()
+    {
+        wwjson::LoggerOptions options;
+        options.block = true;
+        wwjson::Logger logger(fileno(devnull), options);
+        runThreads([&](int t) {
+            for (int i = 0; i < items; ++i)
+            {
+                logger.Info("request done", [&](wwjson::Builder& b) {
+                    b.AddMember("thread", t);
+                    b.AddMember("seq", i);
+                    b.AddMember("path", "/api/v1/items");
+                    b.AddMember("cost", i * 0.125);
+                });
+            }
+        });
+        linesA = static_cast<size_t>(items) * threads - logger.dropped();
+    }
+
+    void methodB()
+    {
+        runThreads([&](int t) {
+            for (int i = 0; i < items; ++i)
+            {
+                wwjson::Builder b(256);
+                b.BeginObject();
+                b.AddMember("ts", std::chrono::duration_cast<std::chrono::microseconds>(
+                                      std::chrono::system_clock::now().time_since_epoch())
+                                      .count());
+                b.AddMember("level", "info");
+                b.AddMemberEscape("msg", "request done");
+                b.AddMember("thread", t);
+                b.AddMember("seq", i);
+                b.AddMember("path", "/api/v1/items");
+                b.AddMember("cost", i * 0.125);
+                b.EndObject();
+                b.GetResult();
+                b.PutChar('\n');
+                std::lock_guard<std::mutex> lock(mutex);
+                std::fwrite(b.json.data(), 1, b.json.size(), devnull);
+            }
+        });
+        linesB = static_cast<size_t>(items) * threads;
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return devnull != nullptr && linesA == linesB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(logger_throughput, "Logger 多线程日志吞吐与互斥锁 fwrite 对比")
+{
+    test::CArgv argv;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 2) { threads = 2; }
+    BIND_ARGV(threads);
+    // each loop runs all threads, scale down the default
+    int loop = argv.loop / 100;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --items=%d --threads=%d --loop=%d (x1/100)", argv.items, threads, argv.loop);
+
+    test::perf::LoggerThroughputTest tester(argv.items, threads);
+    COUT(tester.devnull != nullptr, true);
+    if (tester.devnull == nullptr) { return; }
+
+    double ratio = tester.runAndPrint("Logger Throughput", "Logger",
+                                      "mutex fwrite", loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
@@ -5,6 +5,9 @@
 
 #include "wwjson.hpp"
 #include "jbuilder.hpp"
+#include "jfields.hpp"
+#include "jproject.hpp"
+#include "jtemplate.hpp"
 
 #include <string>
 #include <vector>
@@ -83,6 +86,15 @@ struct RootData
     DataItem data;
 };
 
+// Field descriptors of the same structs, for wwjson::to_json
+WWJSON_FIELDS(DataItem,
+    field_1, field_2, field_3, field_4, field_5, field_6, field_7, field_8, field_9, field_10,
+    field_11, field_12, field_13, field_14, field_15, field_16, field_17, field_18, field_19, field_20,
+    field_21, field_22, field_23, field_24, field_25, field_26, field_27, field_28, field_29, field_30,
+    field_31, field_32, field_33, field_34, field_35, field_36, field_37, field_38, field_39, field_40,
+    field_41, field_42, field_43, field_44, field_45, field_46, field_47, field_48, field_49, field_50)
+WWJSON_FIELDS(RootData, status, code, message, data)
+
 // ============================================================================
 // Builder Method Template
 // ============================================================================
@@ -166,6 +178,91 @@ using RawBuilderMethod = BuilderMethodT<::wwjson::RawBuilder>;
 using BuilderMethod = BuilderMethodT<::wwjson::Builder>;
 using FastBuilderMethod = BuilderMethodT<::wwjson::FastBuilder>;
 
+// ============================================================================
+// Method A2: WWJSON_FIELDS descriptors (pre-rendered key fragments)
+// ============================================================================
+class FieldsMethod
+{
+public:
+    void Build(RootData& data, std::string& out)
+    {
+        ::wwjson::Builder builder(4096);
+        ::wwjson::to_json(builder, data);
+        out = builder.MoveResult();
+    }
+};
+
+// ============================================================================
+// Method A4: FieldProjection (sparse fieldset compiled per request)
+// ============================================================================
+static const char* PROJECTED_JSON =
+    R"({"status":"success","data":{"field_1":"value_001","field_25":"value_025","field_50":"value_050"}})";
+
+class ProjectionMethod
+{
+public:
+    void Build(RootData& data, std::string& out)
+    {
+        auto proj = ::wwjson::FieldProjection::Compile<RootData>(
+            "status,data.field_1,data.field_25,data.field_50");
+        ::wwjson::Builder builder(4096);
+        ::wwjson::to_json_projected(builder, data, proj);
+        out = builder.MoveResult();
+    }
+};
+
+// ============================================================================
+// Method A3: WWJSON_TEMPLATE (literal segments split at compile time)
+// ============================================================================
+class TemplateMethod
+{
+public:
+    void Build(RootData& data, std::string& out)
+    {
+        static constexpr auto tpl = WWJSON_TEMPLATE(
+            R"({"status":{},"code":{},"message":{},"data":{)"
+            R"("field_1":{},"field_2":{},"field_3":{},"field_4":{},"field_5":{},)"
+            R"("field_6":{},"field_7":{},"field_8":{},"field_9":{},"field_10":{},)"
+            R"("field_11":{},"field_12":{},"field_13":{},"field_14":{},"field_15":{},)"
+            R"("field_16":{},"field_17":{},"field_18":{},"field_19":{},"field_20":{},)"
+            R"("field_21":{},"field_22":{},"field_23":{},"field_24":{},"field_25":{},)"
+            R"("field_26":{},"field_27":{},"field_28":{},"field_29":{},"field_30":{},)"
+            R"("field_31":{},"field_32":{},"field_33":{},"field_34":{},"field_35":{},)"
+            R"("field_36":{},"field_37":{},"field_38":{},"field_39":{},"field_40":{},)"
+            R"("field_41":{},"field_42":{},"field_43":{},"field_44":{},"field_45":{},)"
+            R"("field_46":{},"field_47":{},"field_48":{},"field_49":{},"field_50":{})"
+            R"(}})");
+
+        auto& item = data.data;
+        out = tpl.Render(data.status, data.code, data.message,
+            item.field_1, item.field_2,
+            item.field_3, item.field_4,
+            item.field_5, item.field_6,
+            item.field_7, item.field_8,
+            item.field_9, item.field_10,
+            item.field_11, item.field_12,
+            item.field_13, item.field_14,
+            item.field_15, item.field_16,
+            item.field_17, item.field_18,
+            item.field_19, item.field_20,
+            item.field_21, item.field_22,
+            item.field_23, item.field_24,
+            item.field_25, item.field_26,
+            item.field_27, item.field_28,
+            item.field_29, item.field_30,
+            item.field_31, item.field_32,
+            item.field_33, item.field_34,
+            item.field_35, item.field_36,
+            item.field_37, item.field_38,
+            item.field_39, item.field_40,
+            item.field_41, item.field_42,
+            item.field_43, item.field_44,
+            item.field_45, item.field_46,
+            item.field_47, item.field_48,
+            item.field_49, item.field_50);
+    }
+};
+
 // ============================================================================
 // Method B1: snprintf (single format string with all fields)
 // ============================================================================
@@ -864,6 +961,132 @@ public:
     }
 };
 
+// Test: WWJSON_FIELDS vs Builder with AddMember per field
+class FieldsVsBuilder : public RelativeTimer<FieldsVsBuilder>
+{
+public:
+    RootData data;
+    std::string resultA;
+    std::string resultB;
+
+    FieldsVsBuilder() = default;
+
+    void methodA()
+    {
+        FieldsMethod builder;
+        builder.Build(data, resultA);
+    }
+
+    void methodB()
+    {
+        BuilderMethod builder;
+        builder.Build(data, resultB);
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        std::string tempA = resultA;
+        methodB();
+        std::string tempB = resultB;
+        return tempA == tempB && tempA == REFERENCE_JSON;
+    }
+};
+
+// Test: WWJSON_TEMPLATE vs snprintf
+class TemplateVsSnprintf : public RelativeTimer<TemplateVsSnprintf>
+{
+public:
+    RootData data;
+    std::string resultA;
+    std::string resultB;
+
+    TemplateVsSnprintf() = default;
+
+    void methodA()
+    {
+        TemplateMethod builder;
+        builder.Build(data, resultA);
+    }
+
+    void methodB()
+    {
+        SnprintfMethod builder;
+        builder.Build(data, resultB);
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        std::string tempA = resultA;
+        methodB();
+        std::string tempB = resultB;
+        return tempA == tempB && tempA == REFERENCE_JSON;
+    }
+};
+
+// Test: WWJSON_TEMPLATE vs Builder
+class TemplateVsBuilder : public RelativeTimer<TemplateVsBuilder>
+{
+public:
+    RootData data;
+    std::string resultA;
+    std::string resultB;
+
+    TemplateVsBuilder() = default;
+
+    void methodA()
+    {
+        TemplateMethod builder;
+        builder.Build(data, resultA);
+    }
+
+    void methodB()
+    {
+        BuilderMethod builder;
+        builder.Build(data, resultB);
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        std::string tempA = resultA;
+        methodB();
+        std::string tempB = resultB;
+        return tempA == tempB && tempA == REFERENCE_JSON;
+    }
+};
+
+// Test: FieldProjection of 4 paths vs WWJSON_FIELDS full output
+class ProjectionVsFields : public RelativeTimer<ProjectionVsFields>
+{
+public:
+    RootData data;
+    std::string resultA;
+    std::string resultB;
+
+    ProjectionVsFields() = default;
+
+    void methodA()
+    {
+        ProjectionMethod builder;
+        builder.Build(data, resultA);
+    }
+
+    void methodB()
+    {
+        FieldsMethod builder;
+        builder.Build(data, resultB);
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA == PROJECTED_JSON && resultB == REFERENCE_JSON;
+    }
+};
+
 } // namespace test::perf
 
 // ============================================================================
@@ -935,3 +1158,54 @@ DEF_TAST(nodom_fastbuilder_vs_append, "wwjson FastBuilder vs string::append性
     COUT(ratio < 0.9, true);
 }
 
+DEF_TAST(nodom_fields_vs_builder, "WWJSON_FIELDS 预渲染键片段 vs Builder 逐字段性能对比")
+{
+    test::CArgv argv;
+    DESC("Args: --loop=%d", argv.loop);
+
+    auto tester = test::perf::FieldsVsBuilder();
+
+    double ratio = tester.runAndPrint("Fields vs Builder",
+                                      "WWJSON_FIELDS", "Builder",
+                                      argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
+
+DEF_TAST(nodom_template_vs_snprintf, "WWJSON_TEMPLATE vs snprintf性能对比")
+{
+    test::CArgv argv;
+    DESC("Args: --loop=%d", argv.loop);
+
+    auto tester = test::perf::TemplateVsSnprintf();
+
+    double ratio = tester.runAndPrint("Template vs Snprintf",
+                                      "WWJSON_TEMPLATE", "snprintf",
+                                      argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
+
+DEF_TAST(nodom_template_vs_builder, "WWJSON_TEMPLATE vs Builder 逐字段性能对比")
+{
+    test::CArgv argv;
+    DESC("Args: --loop=%d", argv.loop);
+
+    auto tester = test::perf::TemplateVsBuilder();
+
+    double ratio = tester.runAndPrint("Template vs Builder",
+                                      "WWJSON_TEMPLATE", "Builder",
+                                      argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
+
+DEF_TAST(nodom_projection_vs_fields, "FieldProjection 部分字段投影 vs WWJSON_FIELDS 全量性能对比")
+{
+    test::CArgv argv;
+    DESC("Args: --loop=%d", argv.loop);
+
+    auto tester = test::perf::ProjectionVsFields();
+
+    double ratio = tester.runAndPrint("Projection vs Fields",
+                                      "FieldProjection", "WWJSON_FIELDS",
+                                      argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
@@ -0,0 +1,114 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jparallel.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace test::perf
+{
+
+/// 数组元素：几个常见类型字段的小结构体
+struct ParallelRecord
+{
+    int id = 0;
+    std::string name;
+    double score = 0.0;
+    bool active = false;
+    std::vector<int> tags;
+
+    void to_json(wwjson::Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(name);
+        TO_JSON(score);
+        TO_JSON(active);
+        TO_JSON(tags);
+    }
+};
+
+/**
+ * @brief to_json_parallel 多线程与串行 to_json 序列化大数组对比
+ * 方法A: to_json_parallel，线程池 threads-1 个工作线程加调用线程
+ * 方法B: wwjson::to_json 串行
+ */
+class ParallelArrayTest : public RelativeTimer<ParallelArrayTest>
+{
+  public:
+    std::vector<ParallelRecord> records;
+    wwjson::ThreadPool pool;
+    std::string resultA;
+    std::string resultB;
+
+    ParallelArrayTest(int rows, int threads)
+        : pool(threads > 1 ? threads - 1 : 0)
+    {
+        records.reserve(rows);
+        for (int i = 0; i < rows; ++i)
+        {
+            ParallelRecord rec;
+            rec.id = i;
+            rec.name = "record_" + std::to_string(i);
+            rec.score = i * 0.25;
+            rec.active = (i % 3) == 0;
+            for (int k = 0; k < i % 5; ++k) { rec.tags.push_back(i + k); }
+            records.push_back(std::move(rec));
+        }
+    }
+
+    void methodA()
+    {
+        wwjson::Builder builder;
+        wwjson::to_json_parallel(builder, records, pool);
+        resultA = builder.MoveResult().str();
+    }
+
+    void methodB()
+    {
+        wwjson::Builder builder;
+        wwjson::to_json(builder, records);
+        resultB = builder.MoveResult().str();
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA == resultB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(parallel_scaling, "to_json_parallel 大数组 1-N 线程扩展性")
+{
+    test::CArgv argv;
+    int rows = 1000000;
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    int threads = cores;
+    BIND_ARGV(rows);
+    BIND_ARGV(threads);
+    if (threads < 1) { threads = 1; }
+    // each loop serializes the whole large array, scale down the default
+    int loop = argv.loop / 100;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --rows=%d --threads=%d --loop=%d (x1/100)", rows, threads, argv.loop);
+
+    for (int n = 1; n <= threads; n *= 2)
+    {
+        test::perf::ParallelArrayTest tester(rows, n);
+        std::string title = "Parallel Array, threads=" + std::to_string(n);
+        double ratio = tester.runAndPrint(title, "to_json_parallel",
+                                          "to_json", loop, 10);
+        COUTF(std::isnan(ratio), false);
+        // only expect speedup with real cores for each thread
+        if (n > 1 && n <= cores)
+        {
+            COUT(ratio < 1.0, true);
+        }
+    }
+}
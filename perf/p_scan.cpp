@@ -0,0 +1,115 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jbuilder.hpp"
+#include "jscan.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "yyjson.h"
+
+namespace test::perf
+{
+
+/**
+ * @brief 按需扫描取子树转发与完整 DOM 解析对比
+ * 上游响应含 meta 大对象、items 数组与 total，需转发 /data/items 与 /data/total。
+ * 方法A: scan_path 结构跳过取原始片段，AddMemberSub 拼接
+ * 方法B: yyjson 完整解析，按 JSON Pointer 取值后序列化再拼接
+ */
+class ScanVsDomTest : public RelativeTimer<ScanVsDomTest>
+{
+  public:
+    std::string upstream;
+    std::string resultA;
+    std::string resultB;
+
+    explicit ScanVsDomTest(int items)
+    {
+        std::string text(48, 'x');
+        wwjson::Builder builder(items * 256);
+        builder.BeginObject();
+        builder.AddMember("code", 0);
+        builder.AddMember("msg", "ok");
+        builder.PutKey("data");
+        builder.BeginObject();
+        builder.PutKey("meta");
+        builder.BeginArray();
+        for (int i = 0; i < items; ++i)
+        {
+            builder.BeginObject();
+            builder.AddMember("key", i);
+            builder.AddMember("note", text);
+            builder.AddMember("weight", i * 7 % 100);
+            builder.EndObject();
+        }
+        builder.EndArray();
+        builder.PutKey("items");
+        builder.BeginArray();
+        for (int i = 0; i < items; ++i)
+        {
+            builder.BeginObject();
+            builder.AddMember("id", i);
+            builder.AddMember("name", text);
+            builder.AddMember("ok", i % 2 == 0);
+            builder.EndObject();
+        }
+        builder.EndArray();
+        builder.AddMember("total", items);
+        builder.EndObject();
+        builder.EndObject();
+        upstream = builder.GetResult().str();
+    }
+
+    void methodA()
+    {
+        wwjson::RawBuilder builder(upstream.size() / 2);
+        builder.BeginObject();
+        builder.AddMemberSub("items", wwjson::scan_path(upstream, "/data/items"));
+        builder.AddMemberSub("total", wwjson::scan_path(upstream, "/data/total"));
+        builder.EndObject();
+        resultA = builder.MoveResult();
+    }
+
+    void methodB()
+    {
+        wwjson::RawBuilder builder(upstream.size() / 2);
+        yyjson_doc* doc = yyjson_read(upstream.data(), upstream.size(), 0);
+        yyjson_val* items = yyjson_doc_ptr_getn(doc, "/data/items", 11);
+        yyjson_val* total = yyjson_doc_ptr_getn(doc, "/data/total", 11);
+        size_t len = 0;
+        char* text = yyjson_val_write(items, 0, &len);
+        builder.BeginObject();
+        builder.AddMemberSub("items", text, len);
+        builder.AddMember("total", yyjson_get_int(total));
+        builder.EndObject();
+        resultB = builder.MoveResult();
+        ::free(text);
+        yyjson_doc_free(doc);
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA == resultB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(scan_vs_dom, "scan_path 按需取子树 vs yyjson 完整解析后取值")
+{
+    test::CArgv argv;
+    DESC("Args: --items=%d --loop=%d", argv.items, argv.loop);
+
+    test::perf::ScanVsDomTest tester(argv.items);
+    DESC("upstream size: %zu", tester.upstream.size());
+    double ratio = tester.runAndPrint("Scan vs DOM", "scan_path",
+                                      "yyjson read", argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
@@ -0,0 +1,106 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jbuilder.hpp"
+#include "jstatic.hpp"
+
+#include <array>
+#include <cmath>
+#include <string>
+
+namespace test::perf
+{
+
+constexpr const char* kRegionNames[] = {"Africa", "Americas", "Asia", "Europe", "Oceania"};
+
+struct Region
+{
+    int id = 0;
+    const char* name = "";
+    int zone = 0;
+    bool active = false;
+
+    constexpr auto to_static_json() const
+    {
+        return wwjson::static_object(wwjson::static_member("id", id),
+            wwjson::static_member("name", name), wwjson::static_member("zone", zone),
+            wwjson::static_member("active", active));
+    }
+
+    void to_json(wwjson::Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(name);
+        TO_JSON(zone);
+        TO_JSON(active);
+    }
+};
+
+constexpr std::array<Region, 200> MakeRegions()
+{
+    std::array<Region, 200> regions{};
+    for (int i = 0; i < 200; ++i)
+    {
+        regions[i] = Region{1000 + i, kRegionNames[i % 5], i * 7 - 300, i % 3 != 0};
+    }
+    return regions;
+}
+
+constexpr auto kRegions = MakeRegions();
+
+/**
+ * @brief 静态表编译期 JSON 嵌入与运行时序列化对比
+ * 每次构建一个响应：少量动态字段加 200 项静态区域表。
+ * 方法A: WWJSON_STATIC 编译期生成，AddMemberSub 直接拷贝
+ * 方法B: 每次用 to_json 运行时序列化静态表
+ */
+class StaticVsRuntimeTest : public RelativeTimer<StaticVsRuntimeTest>
+{
+  public:
+    std::string resultA;
+    std::string resultB;
+    int seq = 0;
+
+    void methodA()
+    {
+        static constexpr auto kRegionsJson = WWJSON_STATIC(kRegions);
+        wwjson::Builder builder(kRegionsJson.size() + 64);
+        builder.BeginObject();
+        builder.AddMember("seq", seq);
+        builder.AddMemberSub("regions", kRegionsJson.view());
+        builder.EndObject();
+        resultA = builder.MoveResult().str();
+    }
+
+    void methodB()
+    {
+        wwjson::Builder builder;
+        builder.BeginObject();
+        builder.AddMember("seq", seq);
+        wwjson::to_json(builder, "regions", kRegions);
+        builder.EndObject();
+        resultB = builder.MoveResult().str();
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA == resultB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(static_vs_runtime, "WWJSON_STATIC 编译期静态表 vs 运行时序列化")
+{
+    test::CArgv argv;
+    DESC("Args: --loop=%d", argv.loop);
+
+    test::perf::StaticVsRuntimeTest tester;
+    double ratio = tester.runAndPrint("Static vs Runtime", "WWJSON_STATIC",
+                                      "to_json", argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
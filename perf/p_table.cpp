@@ -0,0 +1,98 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jtable.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace test::perf
+{
+
+struct MetricRow
+{
+    int64_t ts;
+    double val;
+    std::string tag;
+    void to_json(wwjson::Builder& builder) const
+    {
+        TO_JSON(ts);
+        TO_JSON(val);
+        TO_JSON(tag);
+    }
+};
+
+/**
+ * @brief 列存数据直接按行输出与转置为结构体后 to_json 对比
+ * 三列 ts/val/tag 各 rows 行（默认 10^6）。
+ * 方法A: TableWriter 预渲染键片段，按列类型写值，整表一次预留
+ * 方法B: 先转置为 vector<MetricRow>，再用 wwjson::to_json 序列化
+ */
+class TableVsTransposeTest : public RelativeTimer<TableVsTransposeTest>
+{
+  public:
+    std::vector<int64_t> ts;
+    std::vector<double> val;
+    std::vector<std::string> tag;
+    std::string resultA;
+    std::string resultB;
+
+    explicit TableVsTransposeTest(int rows)
+    {
+        static const char* kTags[] = {"cpu", "memory", "disk", "network"};
+        ts.reserve(rows);
+        val.reserve(rows);
+        tag.reserve(rows);
+        for (int i = 0; i < rows; ++i)
+        {
+            ts.push_back(1700000000000LL + i * 1000LL);
+            val.push_back(i * 0.25);
+            tag.push_back(kTags[i % 4]);
+        }
+    }
+
+    void methodA()
+    {
+        auto table = wwjson::make_table(wwjson::column("ts", ts), wwjson::column("val", val),
+                                        wwjson::column("tag", tag));
+        resultA = table.Render();
+    }
+
+    void methodB()
+    {
+        std::vector<MetricRow> rows;
+        rows.reserve(ts.size());
+        for (size_t i = 0; i < ts.size(); ++i) { rows.push_back(MetricRow{ts[i], val[i], tag[i]}); }
+        wwjson::Builder builder;
+        wwjson::to_json(builder, rows);
+        resultB = builder.MoveResult().str();
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA == resultB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(table_vs_transpose, "TableWriter 列存直接输出 vs 转置结构体后 to_json（10^6 行）")
+{
+    test::CArgv argv;
+    int rows = 1000000;
+    BIND_ARGV(rows);
+    // each loop writes the whole table, scale down the default
+    int loop = argv.loop / 100;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --rows=%d --loop=%d (x1/100)", rows, argv.loop);
+
+    test::perf::TableVsTransposeTest tester(rows);
+    double ratio = tester.runAndPrint("Table vs Transpose", "TableWriter",
+                                      "transpose + to_json", loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
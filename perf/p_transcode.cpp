@@ -0,0 +1,97 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+#include "perf_util.h"
+
+#include "jtranscode.hpp"
+
+#include <cmath>
+#include <string>
+
+namespace test::perf
+{
+
+/**
+ * @brief 流式改写与整段复制（memcpy 上限）对比
+ * 上游数组每项含 id、ts、name、debug 字段，字符串占多数。
+ * 方法A: transcode 逐令牌改写，可带规则（删除 debug、改名 ts、id 加引号）
+ * 方法B: PutSub 整段复制输入，作为吞吐上限
+ */
+class TranscodeVsCopyTest : public RelativeTimer<TranscodeVsCopyTest>
+{
+  public:
+    std::string upstream;
+    wwjson::TranscodeRules rules;
+    std::string resultA;
+    std::string resultB;
+
+    TranscodeVsCopyTest(int items, bool withRules)
+    {
+        std::string text(40, 'x');
+        wwjson::Builder builder(items * 160);
+        builder.BeginArray();
+        for (int i = 0; i < items; ++i)
+        {
+            builder.BeginObject();
+            builder.AddMember("id", 100000 + i);
+            builder.AddMember("ts", 1700000000 + i);
+            builder.AddMember("name", text);
+            builder.PutKey("debug");
+            builder.BeginObject();
+            builder.AddMember("host", "node-1");
+            builder.AddMember("cost", i % 97);
+            builder.EndObject();
+            builder.EndObject();
+        }
+        builder.EndArray();
+        upstream = builder.GetResult().str();
+
+        if (withRules)
+        {
+            rules.Drop("debug").Rename("ts", "time").Quote("id");
+        }
+    }
+
+    void methodA()
+    {
+        wwjson::RawBuilder builder(upstream.size() + 16);
+        wwjson::transcode(builder, upstream, rules);
+        resultA = builder.MoveResult();
+    }
+
+    void methodB()
+    {
+        wwjson::RawBuilder builder(upstream.size() + 16);
+        builder.AddItemSub(upstream);
+        resultB = builder.MoveResult();
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        if (rules.empty()) { return resultA == resultB; }
+        return resultA.size() < resultB.size() && test::IsJsonValid(resultA);
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(transcode_vs_copy, "transcode 流式改写 vs 整段复制")
+{
+    test::CArgv argv;
+    DESC("Args: --items=%d --loop=%d", argv.items, argv.loop);
+
+    DESC("no rules: token copy only");
+    test::perf::TranscodeVsCopyTest plain(argv.items, false);
+    double ratio = plain.runAndPrint("Transcode vs Copy", "transcode",
+                                     "PutSub copy", argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+
+    DESC("rules: drop debug, rename ts, quote id");
+    test::perf::TranscodeVsCopyTest rewrite(argv.items, true);
+    ratio = rewrite.runAndPrint("Transcode vs Copy", "transcode with rules",
+                                "PutSub copy", argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
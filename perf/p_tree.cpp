@@ -0,0 +1,121 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jtree.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace test::perf
+{
+
+struct TreeNode
+{
+    int id = 0;
+    std::string name;
+    std::vector<TreeNode> kids;
+
+    /// Recursive form through to_json_impl.
+    void to_json(wwjson::Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(name);
+        TO_JSON(kids);
+    }
+};
+
+} // namespace test::perf
+
+template <>
+struct wwjson::TreeTraits<test::perf::TreeNode>
+{
+    static constexpr const char* kChildrenKey = "kids";
+    static const auto& Children(const test::perf::TreeNode& node) { return node.kids; }
+    template <typename builderT>
+    static void WriteFields(builderT& builder, const test::perf::TreeNode& node)
+    {
+        builder.AddMember("id", node.id);
+        builder.AddMember("name", node.name);
+    }
+};
+
+namespace test::perf
+{
+
+/**
+ * @brief 显式栈迭代序列化与递归 to_json 对比：深度伸缩
+ * 根节点下挂若干条深度为 depth 的单链，总节点数约为 nodes，
+ * 深度越大形状越窄深，递归调用开销占比越高。
+ * 方法A: to_json_tree 显式栈迭代
+ * 方法B: 节点 to_json 方法经 to_json_impl 递归
+ */
+class TreeVsRecursiveTest : public RelativeTimer<TreeVsRecursiveTest>
+{
+  public:
+    TreeNode root;
+    std::string resultA;
+    std::string resultB;
+
+    TreeVsRecursiveTest(int nodes, int depth)
+    {
+        int chains = nodes / depth;
+        if (chains < 1) { chains = 1; }
+        int id = 0;
+        root.kids.resize(chains);
+        for (auto& head : root.kids)
+        {
+            TreeNode* tail = &head;
+            for (int d = 0; d < depth; ++d)
+            {
+                tail->id = ++id;
+                tail->name = "n" + std::to_string(id % 100);
+                if (d + 1 < depth)
+                {
+                    tail->kids.resize(1);
+                    tail = &tail->kids[0];
+                }
+            }
+        }
+    }
+
+    void methodA()
+    {
+        resultA = wwjson::to_json_tree(root);
+    }
+
+    void methodB()
+    {
+        resultB = wwjson::to_json(root);
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA == resultB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(tree_vs_recursive, "to_json_tree 显式栈迭代 vs 递归 to_json（深度伸缩）")
+{
+    test::CArgv argv;
+    int nodes = 10000;
+    BIND_ARGV(nodes);
+    int loop = argv.loop / 10;
+    if (loop < 1) { loop = 1; }
+    DESC("Args: --nodes=%d --loop=%d (x1/10)", nodes, argv.loop);
+
+    for (int depth : {1, 10, 100, 1000})
+    {
+        DESC("depth = %d", depth);
+        test::perf::TreeVsRecursiveTest tester(nodes, depth);
+        double ratio = tester.runAndPrint("Tree vs Recursive", "to_json_tree",
+                                          "recursive to_json", loop, 10);
+        COUTF(std::isnan(ratio), false);
+    }
+}
@@ -0,0 +1,128 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "juring.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace test::perf
+{
+
+/// Read whole content of a stdio stream from beginning.
+static std::string ReadFileContent(FILE* fp)
+{
+    std::string content;
+    std::fflush(fp);
+    std::rewind(fp);
+    char buf[4096];
+    size_t n = 0;
+    while ((n = std::fread(buf, 1, sizeof(buf), fp)) > 0)
+    {
+        content.append(buf, n);
+    }
+    return content;
+}
+
+/**
+ * @brief AsyncWriter (io_uring) 与同步 write 输出多个 json 文档对比
+ * 每次迭代构建 items 个小 json 文档（每个一行），写入本地临时文件。
+ * 方法A: 从 AsyncWriter 池中取缓冲构建，提交后不等待，迭代末尾 drain
+ * 方法B: Builder 构建后直接调用阻塞的 ::write
+ */
+class UringWriteTest : public RelativeTimer<UringWriteTest>
+{
+  public:
+    int items;
+    FILE* fileA = nullptr;
+    FILE* fileB = nullptr;
+    bool async = false;
+
+    UringWriteTest(int n) : items(n)
+    {
+        fileA = std::tmpfile();
+        fileB = std::tmpfile();
+    }
+
+    ~UringWriteTest()
+    {
+        if (fileA) { std::fclose(fileA); }
+        if (fileB) { std::fclose(fileB); }
+    }
+
+    template <typename builderT>
+    void buildLine(builderT& builder, int id)
+    {
+        builder.BeginObject();
+        builder.AddMember("id", id);
+        builder.AddMember("name", "async_writer_benchmark");
+        builder.AddMember("score", id * 0.125);
+        builder.AddMember("active", (id & 1) == 0);
+        builder.EndObject();
+        builder.PutChar('\n');
+    }
+
+    void methodA()
+    {
+        wwjson::AsyncWriter writer(fileno(fileA));
+        async = writer.async();
+        for (int i = 0; i < items; ++i)
+        {
+            wwjson::Builder builder(writer.acquire(256), 0);
+            buildLine(builder, i);
+            writer.submit(builder.MoveResult());
+        }
+        writer.drain();
+    }
+
+    void methodB()
+    {
+        int fd = fileno(fileB);
+        for (int i = 0; i < items; ++i)
+        {
+            wwjson::Builder builder(256);
+            buildLine(builder, i);
+            auto& json = builder.GetResult();
+            const char* data = json.data();
+            size_t len = json.size();
+            while (len > 0)
+            {
+                ssize_t n = ::write(fd, data, len);
+                if (n <= 0) { break; }
+                data += n;
+                len -= static_cast<size_t>(n);
+            }
+        }
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        std::string contentA = ReadFileContent(fileA);
+        std::string contentB = ReadFileContent(fileB);
+        // tests append to the file end from now on
+        ::lseek(fileno(fileA), 0, SEEK_END);
+        ::lseek(fileno(fileB), 0, SEEK_END);
+        return !contentA.empty() && contentA == contentB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(uring_vs_write, "AsyncWriter 异步写文件与同步 write 对比")
+{
+    test::CArgv argv;
+    DESC("Args: --items=%d --loop=%d", argv.items, argv.loop);
+    test::perf::UringWriteTest tester(argv.items);
+    COUT(tester.fileA != nullptr && tester.fileB != nullptr, true);
+    if (tester.fileA == nullptr || tester.fileB == nullptr) { return; }
+
+    double ratio = tester.runAndPrint("Async Writer", "AsyncWriter",
+                                      "::write", argv.loop, 10);
+    COUT(tester.async);
+    COUTF(std::isnan(ratio), false);
+}
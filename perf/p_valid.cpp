@@ -0,0 +1,78 @@
+#include "couttast/tinytast.hpp"
+
+#include "argv.h"
+#include "relative_perf.h"
+
+#include "jbuilder.hpp"
+#include "jvalid.hpp"
+#include "xyjson.h"
+
+#include <cmath>
+#include <string>
+
+namespace test::perf
+{
+
+/**
+ * @brief 免分配校验器与完整解析校验对比
+ * 由 Builder 构建 items 个对象的数组，含整数、浮点、转义与中文字符串。
+ * 方法A: wwjson::is_json_valid 只检查语法，不分配内存
+ * 方法B: xyjson Document 完整解析为 DOM 后判断是否有效
+ */
+class ValidVsParseTest : public RelativeTimer<ValidVsParseTest>
+{
+  public:
+    std::string json;
+    bool resultA = false;
+    bool resultB = false;
+
+    explicit ValidVsParseTest(int items)
+    {
+        wwjson::Builder builder(items * 96);
+        builder.BeginArray();
+        for (int i = 0; i < items; ++i)
+        {
+            builder.BeginObject();
+            builder.AddMember("id", i);
+            builder.AddMember("price", i * 0.25);
+            builder.AddMember("name", "item \\\"quoted\\\" 名称");
+            builder.AddMember("tags", "alpha,beta,gamma,delta");
+            builder.AddMember("ok", i % 3 == 0);
+            builder.EndObject();
+        }
+        builder.EndArray();
+        json = builder.GetResult().str();
+    }
+
+    void methodA()
+    {
+        resultA = wwjson::is_json_valid(json);
+    }
+
+    void methodB()
+    {
+        yyjson::Document doc(json);
+        resultB = doc.isValid();
+    }
+
+    bool methodVerify()
+    {
+        methodA();
+        methodB();
+        return resultA && resultB;
+    }
+};
+
+} // namespace test::perf
+
+DEF_TAST(valid_vs_parse, "is_json_valid 免分配校验 vs 完整解析校验")
+{
+    test::CArgv argv;
+    DESC("Args: --items=%d --loop=%d", argv.items, argv.loop);
+
+    test::perf::ValidVsParseTest tester(argv.items);
+    DESC("json size: %zu", tester.json.size());
+    double ratio = tester.runAndPrint("Valid vs Parse", "is_json_valid",
+                                      "xyjson Document", argv.loop, 10);
+    COUTF(std::isnan(ratio), false);
+}
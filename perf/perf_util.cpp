@@ -1,5 +1,5 @@
 #include "perf_util.h"
-#include "xyjson.h"
+#include "jvalid.hpp"
 
 #include <string>
 
@@ -8,15 +8,12 @@ namespace test
 
 bool IsJsonValid(const std::string &json)
 {
-    yyjson::Document doc(json);
-    return doc.isValid();
+    return wwjson::is_json_valid(json);
 }
 
 bool IsJsonEqual(const std::string &left, const std::string& right)
 {
-    yyjson::Document docLeft(left);
-    yyjson::Document docRight(right);
-    return docLeft.isValid() && docRight.isValid() && left == right;
+    return wwjson::is_json_valid(left) && wwjson::is_json_valid(right) && left == right;
 }
 
 } // namespace test
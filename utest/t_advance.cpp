@@ -773,3 +773,56 @@ DEF_TAST(advance_function_scope_with_callable, "scope 对象与可调用函数
     COUT(builder2.GetResult(), expect2);
     COUT(test::IsJsonValid(builder2.json), true);
 }
+
+DEF_TAST(advance_lazy_value, "lazy 延迟成员值与字段掩码测试")
+{
+    int calls = 0;
+    auto compute = [&calls]() { ++calls; return 42; };
+
+    // Without mask, lazy values are computed when written
+    wwjson::RawBuilder builder1;
+    builder1.BeginObject();
+    builder1.AddMember("id", 1);
+    builder1.AddMember("score", wwjson::lazy(compute));
+    builder1.AddMember("name", wwjson::lazy([]() { return std::string("Alice"); }));
+    builder1.AddMember("ok", wwjson::lazy(0, []() { return true; }));
+    builder1.EndObject();
+
+    std::string expect1 = R"({"id":1,"score":42,"name":"Alice","ok":true})";
+    COUT(builder1.GetResult(), expect1);
+    COUT(calls, 1);
+
+    // Masked out fields skip both key and computation
+    calls = 0;
+    wwjson::RawBuilder builder2;
+    builder2.SetFieldMask(1u << 1);
+    COUT(builder2.HasField(0), false);
+    COUT(builder2.HasField(1), true);
+    COUT(builder2.HasField(-1), true);
+    builder2.BeginObject();
+    builder2.AddMember("a", wwjson::lazy(0, compute));
+    builder2.AddMember("b", wwjson::lazy(1, compute));
+    builder2.AddMember("c", wwjson::lazy(2, compute));
+    builder2.EndObject();
+
+    std::string expect2 = R"({"b":42})";
+    COUT(builder2.GetResult(), expect2);
+    COUT(calls, 1);
+    COUT(test::IsJsonValid(builder2.json), true);
+
+    // All members masked out, and lazy array items via scope objects
+    wwjson::RawBuilder builder3;
+    builder3.SetFieldMask(0);
+    {
+        auto root = builder3.ScopeObject();
+        root.AddMember("x", wwjson::lazy(5, compute));
+        auto arr = root.ScopeArray("list");
+        auto item = wwjson::lazy(5, []() { return 3.5; });
+        arr.AddItem(item);
+        arr.AddItem(wwjson::lazy([]() { return "text"; }));
+    }
+
+    std::string expect3 = R"({"list":[3.5,"text"]})";
+    COUT(builder3.GetResult(), expect3);
+    COUT(test::IsJsonValid(builder3.json), true);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file t_batch.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for BatchBuilder from include/jbatch.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jbatch.hpp"
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+DEF_TAST(batch_documents, "BatchBuilder 多文档连续写入与索引")
+{
+    BatchBuilder batch(256);
+
+    DESC("逐个提交文档");
+    for (int i = 0; i < 3; ++i)
+    {
+        Builder& builder = batch.Begin();
+        builder.BeginObject();
+        builder.AddMember("id", i);
+        builder.EndObject();
+        COUT(batch.Commit(), i);
+    }
+    COUT(batch.size(), 3);
+    COUT(batch[0], R"({"id":0})");
+    COUT(batch[2], R"({"id":2})");
+    COUT(batch.view(), R"({"id":0}{"id":1}{"id":2})");
+    COUT(batch.index()[1].offset, 8);
+
+    DESC("回滚当前文档");
+    batch.Begin().AddItem("partial");
+    COUT(batch.bytes(), 24);
+    batch.Rollback();
+    COUT(batch.size(), 3);
+    COUT(batch.view().size(), 24);
+
+    DESC("Add 回调返回 false 时回滚");
+    bool ok = batch.Add([](Builder& b) {
+        b.BeginArray();
+        b.AddItem(1);
+        return false;
+    });
+    COUT(ok, false);
+    ok = batch.Add([](Builder& b) {
+        b.BeginArray();
+        b.AddItem(1);
+        b.EndArray();
+    });
+    COUT(ok, true);
+    COUT(batch.size(), 4);
+    COUT(batch[3], "[1]");
+
+    DESC("清空后复用内存");
+    size_t cap = batch.capacity();
+    batch.Clear();
+    COUT(batch.empty(), true);
+    COUT(batch.bytes(), 0);
+    batch.AddValue(std::vector<int>{7, 8});
+    COUT(batch[0], "[7,8]");
+    COUT(batch.capacity(), cap);
+}
+
+DEF_TAST(batch_delimiter, "BatchBuilder 分隔符输出 NDJSON")
+{
+    BatchBuilder batch(64, '\n');
+    for (int i = 0; i < 100; ++i)
+    {
+        batch.AddValue(std::vector<std::string>{"msg", std::to_string(i)});
+    }
+    COUT(batch.size(), 100);
+    COUT(batch[99], R"(["msg","99"])");
+    COUT(batch.view().substr(0, 24), "[\"msg\",\"0\"]\n[\"msg\",\"1\"]\n");
+    COUT(batch.view().back(), '\n');
+
+    bool valid = true;
+    size_t lines = 0;
+    std::string_view all = batch.view();
+    for (size_t pos = 0; pos < all.size(); ++lines)
+    {
+        size_t end = all.find('\n', pos);
+        valid = valid && all.substr(pos, end - pos) == batch[lines]
+            && test::IsJsonValid(std::string(batch[lines]));
+        pos = end + 1;
+    }
+    COUT(lines, 100);
+    COUT(valid, true);
+}
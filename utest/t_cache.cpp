@@ -0,0 +1,293 @@
+/**
+ * @file t_cache.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for RenderCache from include/jcache.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jcache.hpp"
+#include "jsink.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wwjson;
+
+namespace
+{
+
+/// Build a response, with values or slot placeholders.
+template <typename codeT, typename userT, typename scoreT>
+void BuildResponse(Builder& builder, const codeT& code, const userT& user, const scoreT& score)
+{
+    builder.BeginObject();
+    builder.AddMember("code", code);
+    builder.BeginObject("config");
+    builder.AddMember("region", "east");
+    builder.AddMember("limit", 100);
+    builder.BeginArray("features");
+    for (int i = 0; i < 5; ++i) { builder.AddItem(i * 2); }
+    builder.EndArray();
+    builder.EndObject();
+    builder.AddMember("user", user);
+    builder.BeginArray("scores");
+    builder.AddItem(score);
+    builder.AddItem(true);
+    builder.EndArray();
+    builder.EndObject();
+}
+
+std::string Expect(int code, const std::string& user, double score)
+{
+    Builder builder;
+    BuildResponse(builder, code, user, score);
+    return builder.MoveResult().str();
+}
+
+struct User
+{
+    int id = 0;
+    std::string name;
+    std::vector<std::string> roles;
+
+    void to_json(Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(name);
+        TO_JSON(roles);
+    }
+};
+
+/// Writable by any builder type.
+struct Score
+{
+    int value = 0;
+    std::string note;
+
+    template <typename builderT>
+    void to_json(builderT& builder) const
+    {
+        TO_JSON(value);
+        TO_JSON(note);
+    }
+};
+
+struct QuoteKConfig : UnsafeConfig<KString>
+{
+    static constexpr bool kQuoteNumber = true;
+    static constexpr bool kEscapeValue = true;
+};
+
+std::shared_ptr<User> MakeUser(int id)
+{
+    auto user = std::make_shared<User>();
+    user->id = id;
+    user->name = "user_" + std::to_string(id);
+    user->roles = {"reader", "writer"};
+    return user;
+}
+
+/// Feed of posts referring to shared authors, through the memo or not.
+std::string BuildFeed(const std::vector<std::shared_ptr<User>>& authors, int posts, MemoCache* memo)
+{
+    Builder builder;
+    builder.BeginArray();
+    for (int i = 0; i < posts; ++i)
+    {
+        const auto& author = authors[i % authors.size()];
+        builder.BeginObject();
+        builder.AddMember("post", i);
+        if (memo) { memo->to_json(builder, "author", author); }
+        else { wwjson::to_json(builder, "author", *author); }
+        builder.EndObject();
+    }
+    builder.EndArray();
+    return builder.MoveResult().str();
+}
+
+} // namespace
+
+DEF_TAST(cache_record, "RenderCache 记录结构并以新值重新渲染")
+{
+    RenderCache cache;
+    COUT(cache.valid(), false);
+    COUT(cache.Render(1, "x", 2.0).empty(), true);
+
+    auto slot = RenderCache::Slot();
+    COUT(cache.Record([&](Builder& b) { BuildResponse(b, slot, slot, slot); }, 1), 3);
+    COUT(cache.valid(1), true);
+    COUT(cache.valid(2), false);
+    COUT(cache.slots(), 3);
+
+    DESC("多次渲染与完整构建一致");
+    for (int i = 0; i < 3; ++i)
+    {
+        std::string user = "user_" + std::to_string(i);
+        std::string json = cache.Render(200 + i, user, i * 1.5);
+        COUT(json == Expect(200 + i, user, i * 1.5), true);
+    }
+    COUT(test::IsJsonValid(cache.Render(0, "u", 0.5)), true);
+
+    DESC("参数个数不符时不写出");
+    {
+        Builder builder;
+        COUT(cache.Write(builder, 1, 2), false);
+        COUT(builder.Size(), 0);
+        COUT(cache.Render(1, 2).empty(), true);
+    }
+
+    DESC("空值、可选与追加到数组");
+    {
+        Builder builder;
+        builder.BeginArray();
+        std::optional<int> none;
+        COUT(cache.Write(builder, none, nullptr, std::optional<double>(2.5)), true);
+        builder.SepItem();
+        builder.EndArray();
+        std::string json = builder.MoveResult().str();
+        COUT(test::IsJsonValid(json), true);
+        COUT(json.find(R"("code":null)") != std::string::npos, true);
+        COUT(json.find(R"("scores":[2.5,true])") != std::string::npos, true);
+    }
+
+    DESC("失效后重新记录不同结构");
+    cache.Invalidate();
+    COUT(cache.valid(1), false);
+    cache.Record([&](Builder& b) {
+        b.BeginArray();
+        b.AddItem(slot);
+        b.AddItem("const");
+        b.EndArray();
+    }, 2);
+    COUT(cache.valid(2), true);
+    COUT(cache.Render(std::string("v")), R"(["v","const"])");
+}
+
+DEF_TAST(cache_memo, "MemoCache 共享对象序列化片段的记忆")
+{
+    std::vector<std::shared_ptr<User>> authors;
+    for (int i = 0; i < 4; ++i) { authors.push_back(MakeUser(i)); }
+    std::string expect = BuildFeed(authors, 40, nullptr);
+    COUT(test::IsJsonValid(expect), true);
+
+    DESC("命中时拼接缓存片段");
+    MemoCache memo;
+    COUT(BuildFeed(authors, 40, &memo) == expect, true);
+    COUT(memo.misses(), 4);
+    COUT(memo.hits(), 36);
+    COUT(BuildFeed(authors, 40, &memo) == expect, true);
+    COUT(memo.hits(), 76);
+
+    DESC("版本变化与空指针");
+    {
+        Builder builder;
+        builder.BeginArray();
+        authors[0]->name = "renamed";
+        memo.to_json(builder, authors[0], 1);
+        memo.to_json(builder, authors[0], 1);
+        memo.to_json(builder, std::shared_ptr<User>());
+        builder.EndArray();
+        COUT(memo.misses(), 5);
+        std::string json = builder.MoveResult().str();
+        COUT(json.find("renamed") != std::string::npos, true);
+        COUT(json.substr(json.size() - 6), ",null]");
+    }
+
+    DESC("对象释放后同地址新对象不命中");
+    {
+        auto temp = MakeUser(100);
+        Builder builder;
+        memo.to_json(builder, temp);
+        size_t misses = memo.misses();
+        temp.reset();
+        auto other = MakeUser(200);
+        memo.to_json(builder, other);
+        COUT(memo.misses(), misses + 1);
+        COUT(builder.MoveResult().str().find("user_200") != std::string::npos, true);
+    }
+
+    DESC("内存预算与清空");
+    {
+        MemoCache small(400, 2);
+        std::vector<std::shared_ptr<User>> many;
+        for (int i = 0; i < 50; ++i) { many.push_back(MakeUser(i)); }
+        COUT(BuildFeed(many, 100, &small) == BuildFeed(many, 100, nullptr), true);
+        COUT(small.bytes() <= 400, true);
+        small.Clear();
+        COUT(small.bytes(), 0);
+    }
+
+    DESC("KString 构建器的片段沿用其配置");
+    {
+        auto score = std::make_shared<Score>(Score{42, "a\tb"});
+        MemoCache quoted;
+        for (int i = 0; i < 2; ++i)
+        {
+            GenericBuilder<KString, QuoteKConfig> builder(256);
+            builder.BeginObject();
+            quoted.to_json(builder, "score", score);
+            builder.EndObject();
+            COUT(builder.GetResult().str(), R"({"score":{"value":"42","note":"a\tb"}})");
+        }
+        COUT(quoted.misses(), 1);
+
+        FastBuilder fast(4096);
+        fast.BeginArray();
+        quoted.Clear();
+        quoted.to_json(fast, authors[1]);
+        fast.EndArray();
+        Builder plain;
+        plain.BeginArray();
+        wwjson::to_json(plain, *authors[1]);
+        plain.EndArray();
+        COUT(fast.GetResult().str() == plain.GetResult().str(), true);
+    }
+
+    DESC("FlushBuilder 的大片段完整写出并缓存");
+    {
+        auto big = MakeUser(7);
+        for (int i = 0; i < 500; ++i) { big->roles.push_back("role" + std::to_string(i)); }
+        Builder plain;
+        plain.BeginObject();
+        wwjson::to_json(plain, "author", *big);
+        plain.EndObject();
+        std::string expect_big = plain.MoveResult().str();
+
+        MemoCache flushed;
+        for (int i = 0; i < 2; ++i)
+        {
+            std::string out;
+            {
+                FlushBuilder builder(FlushString([&out](const char* data, size_t len) {
+                    out.append(data, len);
+                    return true;
+                }, 256), 0);
+                builder.BeginObject();
+                flushed.to_json(builder, "author", big, 1);
+                builder.EndObject();
+                COUT(builder.GetResult().finish(), true);
+            }
+            COUT(out == expect_big, true);
+        }
+        COUT(flushed.misses(), 1);
+        COUT(flushed.hits(), 1);
+    }
+
+    DESC("多线程并发查找与插入");
+    {
+        MemoCache shared(1 << 20, 4);
+        std::vector<std::string> results(4);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t)
+        {
+            workers.emplace_back([&, t] { results[t] = BuildFeed(authors, 200, &shared); });
+        }
+        for (auto& w : workers) { w.join(); }
+        std::string serial = BuildFeed(authors, 200, nullptr);
+        for (auto& r : results) { COUT(r == serial, true); }
+        COUT(shared.hits() + shared.misses(), 800);
+    }
+}
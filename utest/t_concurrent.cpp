@@ -0,0 +1,166 @@
+/**
+ * @file t_concurrent.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for ConcurrentBuffer and SlotBuilder from include/jconcurrent.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jconcurrent.hpp"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wwjson;
+
+namespace
+{
+
+/// Build one json line of a producer into the reserved slot.
+bool WriteLine(ConcurrentBuffer& shared, int producer, int id)
+{
+    auto slot = shared.reserve(128);
+    if (!slot) { return false; }
+    SlotBuilder builder(slot.view(), 0);
+    builder.BeginObject();
+    builder.AddMember("producer", producer);
+    builder.AddMember("id", id);
+    builder.EndObject();
+    builder.GetResult();
+    builder.PutChar('\n');
+    return slot.commit(builder);
+}
+
+/// Split output into sorted lines.
+std::vector<std::string> SortedLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream is(text);
+    std::string line;
+    while (std::getline(is, line)) { lines.push_back(line); }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+}
+
+} // namespace
+
+DEF_TAST(concurrent_slot, "ConcurrentBuffer 预留、提交与按序输出")
+{
+    std::string output;
+    size_t calls = 0;
+    ConcurrentBuffer shared([&](const char* data, size_t len) {
+        output.append(data, len);
+        ++calls;
+        return true;
+    }, 1024, 2);
+
+    DESC("顺序提交的记录连续，一次写出");
+    for (int i = 0; i < 3; ++i) { COUT(WriteLine(shared, 0, i), true); }
+    COUT(shared.flush(), 0);
+    COUT(shared.flush(true) > 0, true);
+    COUT(calls, 1);
+    COUT(output, "{\"producer\":0,\"id\":0}\n{\"producer\":0,\"id\":1}\n{\"producer\":0,\"id\":2}\n");
+
+    DESC("交错提交：未回收的尾部形成间隙，未提交前不输出");
+    output.clear();
+    calls = 0;
+    {
+        auto first = shared.reserve(16);
+        auto second = shared.reserve(16);
+        COUT(!!first && !!second, true);
+        ::memcpy(second.data(), "second\n", 7);
+        second.commit(7);
+        COUT(shared.flush(true), 0);
+        ::memcpy(first.data(), "first\n", 6);
+        first.commit(6);
+    }
+    COUT(shared.flush(), 13);
+    COUT(output, "first\nsecond\n");
+    COUT(calls, 2);
+
+    DESC("超长与截断的文档");
+    {
+        COUT(!!shared.reserve(2048), false);
+        auto slot = shared.reserve(8);
+        SlotBuilder builder(slot.view(), 0);
+        builder.AddItem("a long string value");
+        COUT(slot.commit(builder), false);
+    }
+    COUT(shared.finish(), true);
+    COUT(shared.flushed(), output.size() + 66);
+}
+
+DEF_TAST(concurrent_full, "ConcurrentBuffer 缓冲满时预留失败，刷新后恢复")
+{
+    std::string output;
+    ConcurrentBuffer shared([&](const char* data, size_t len) {
+        output.append(data, len);
+        return true;
+    }, 256, 2);
+
+    int written = 0;
+    while (WriteLine(shared, 1, written)) { ++written; }
+    COUT(written > 0 && written < 30, true);
+    COUT(shared.flush() > 0, true);
+    COUT(WriteLine(shared, 1, written), true);
+    ++written;
+    COUT(shared.finish(), true);
+    COUT(static_cast<int>(SortedLines(output).size()), written);
+
+    DESC("输出端失败");
+    ConcurrentBuffer broken([](const char*, size_t) { return false; }, 256, 2);
+    COUT(WriteLine(broken, 2, 0), true);
+    COUT(broken.finish(), false);
+    COUT(broken.failed(), true);
+}
+
+DEF_TAST(concurrent_threads, "ConcurrentBuffer 多生产者线程与消费者线程")
+{
+    const int kProducers = 4;
+    const int kLines = 5000;
+    std::string output;
+    ConcurrentBuffer shared([&](const char* data, size_t len) {
+        output.append(data, len);
+        return true;
+    }, 4096, 4);
+
+    std::atomic<int> running{kProducers};
+    std::thread consumer([&] {
+        while (running.load() > 0)
+        {
+            if (shared.flush(true) == 0) { std::this_thread::yield(); }
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kLines; ++i)
+            {
+                while (!WriteLine(shared, p, i)) { std::this_thread::yield(); }
+            }
+            --running;
+        });
+    }
+    for (auto& t : producers) { t.join(); }
+    consumer.join();
+    COUT(shared.finish(), true);
+
+    std::vector<std::string> expect;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        for (int i = 0; i < kLines; ++i)
+        {
+            expect.push_back("{\"producer\":" + std::to_string(p) +
+                             ",\"id\":" + std::to_string(i) + "}");
+        }
+    }
+    std::sort(expect.begin(), expect.end());
+    std::vector<std::string> lines = SortedLines(output);
+    COUT(lines.size(), expect.size());
+    COUT(lines == expect, true);
+    COUT(test::IsJsonValid(lines.front()), true);
+}
@@ -0,0 +1,177 @@
+/**
+ * @file t_count.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for CountingString, measure_json and to_json_exact from include/jcount.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jcount.hpp"
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace
+{
+
+struct EscapeConfig : UnsafeConfig<JString>
+{
+    static constexpr bool kEscapeKey = true;
+    static constexpr bool kEscapeValue = true;
+    static constexpr bool kQuoteNumber = true;
+};
+
+/// Build the same mixed document on any builder type.
+template <typename builderT>
+void BuildMixed(builderT& builder)
+{
+    builder.BeginObject();
+    builder.AddMember("int", std::numeric_limits<int64_t>::min());
+    builder.AddMember("uint", std::numeric_limits<uint64_t>::max());
+    builder.AddMember("double", 3.14159);
+    builder.AddMember("float", 0.1f);
+    builder.AddMember("nan", std::numeric_limits<double>::quiet_NaN());
+    builder.AddMember("bool", false);
+    builder.AddMember("null", nullptr);
+    builder.AddMember("text", "line\none \"quoted\"\\");
+    builder.AddMember("key\ttab", "utf8 中文");
+    builder.AddMemberEscape("note", "tab\there");
+    builder.BeginArray("list");
+    for (int i = 0; i < 20; ++i) { builder.AddItem(i * 1.25 - 7); }
+    builder.EndArray();
+    builder.BeginObject("empty");
+    builder.EndObject();
+    builder.EndObject();
+}
+
+struct Article
+{
+    int id = 0;
+    std::string title;
+    std::vector<std::string> tags;
+    std::optional<double> rating;
+    std::map<std::string, int> stats;
+
+    template <typename builderT>
+    void to_json(builderT& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(title);
+        TO_JSON(tags);
+        TO_JSON(rating);
+        TO_JSON(stats);
+    }
+};
+
+} // namespace
+
+DEF_TAST(count_string, "CountingBuilder 计数与实际构建逐字节长度一致")
+{
+    DESC("默认配置");
+    {
+        Builder builder;
+        BuildMixed(builder);
+        CountingBuilder<> counter;
+        BuildMixed(counter);
+        COUT(counter.GetResult().size(), builder.GetResult().size());
+    }
+
+    DESC("转义与数字加引号配置");
+    {
+        GenericBuilder<JString, EscapeConfig> builder;
+        BuildMixed(builder);
+        CountingBuilder<EscapeConfig> counter;
+        BuildMixed(counter);
+        std::string json = builder.GetResult().str();
+        COUT(counter.GetResult().size(), json.size());
+        COUT(test::IsJsonValid(json), true);
+    }
+
+    DESC("measure_json 与标准库容器");
+    {
+        std::vector<std::map<std::string, double>> rows(5);
+        for (int i = 0; i < 5; ++i) { rows[i]["v" + std::to_string(i)] = i / 3.0; }
+        Builder builder;
+        wwjson::to_json(builder, rows);
+        COUT(measure_json(rows), builder.GetResult().size());
+        COUT(measure_json(42), 2);
+        COUT(measure_json(std::vector<int>{}), 2);
+    }
+}
+
+DEF_TAST(count_exact, "to_json_exact 两遍序列化一次精确分配")
+{
+    Article article;
+    article.id = 7;
+    article.title = std::string(3000, 'x');
+    for (int i = 0; i < 10; ++i) { article.tags.push_back("tag" + std::to_string(i)); }
+    article.rating = 4.5;
+    article.stats["views"] = 123456;
+
+    std::string expect = wwjson::to_json(article);
+    COUT(test::IsJsonValid(expect), true);
+
+    DESC("结果类型");
+    std::string json = to_json_exact(article);
+    COUT(json == expect, true);
+    JString js = to_json_exact<JString>(article);
+    COUT(js.str() == expect, true);
+    COUT(js.capacity() < 2 * expect.size(), true);
+
+    DESC("调用者缓冲区，空间不足时只返回长度");
+    {
+        std::vector<char> small(64, '#');
+        size_t n = to_json_exact(article, small.data(), small.size());
+        COUT(n, expect.size());
+        COUT(small[0], '#');
+
+        std::vector<char> exact(n + 2);
+        COUT(to_json_exact(article, exact.data(), exact.size()), n);
+        COUT(std::string(exact.data()) == expect, true);
+
+        std::vector<char> tight(n + 1, '#');
+        COUT(to_json_exact(article, tight.data(), tight.size()), n);
+        COUT(tight[0], '#');
+    }
+
+    DESC("末尾浮点数不引起重新分配");
+    {
+        std::vector<double> values(2000, 1.5);
+        size_t n = measure_json(values);
+        ReleasedBuffer rb = to_json_exact<ReleasedBuffer>(values);
+        COUT(rb.size, n);
+        // a reallocation would at least double the capacity
+        COUT(rb.capacity <= n + 1 + detail::kNumberReserve + KString::kUnsafeLevel + 8, true);
+    }
+}
+
+DEF_TAST(count_exact_float, "to_json_exact 调用者缓冲区恰好够用时浮点数不越界")
+{
+    // measured size plus the trailing comma and '\0', on the heap so that a
+    // write past it is caught by the address sanitizer
+    auto exact = [](const auto& value, const std::string& expect)
+    {
+        size_t n = measure_json(value);
+        std::unique_ptr<char[]> dst(new char[n + 2]);
+        size_t written = to_json_exact(value, dst.get(), n + 2);
+        return written == expect.size() && std::string(dst.get(), written) == expect;
+    };
+
+    DESC("标量浮点数，小数位少于格式化时写入的四位");
+    COUT(exact(0.5, "0.5"), true);
+    COUT(exact(-0.5, "-0.5"), true);
+    COUT(exact(12.25, "12.25"), true);
+    COUT(exact(3.0, "3.0"), true);
+    COUT(exact(1.0 / 3.0, to_json_exact(1.0 / 3.0)), true);
+
+    DESC("数组与对象的最后一项为浮点数");
+    COUT(exact(std::vector<double>{1, 0.5}, "[1.0,0.5]"), true);
+    COUT(exact(std::vector<float>{0.25f, 0.5f}, "[0.25,0.5]"), true);
+    std::map<std::string, double> scores{{"a", 0.5}};
+    COUT(exact(scores, R"({"a":0.5})"), true);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file t_delta.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for DeltaJson from include/jdelta.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jdelta.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace delta_test
+{
+
+struct Quote
+{
+    int bid = 0;
+    int ask = 0;
+};
+WWJSON_FIELDS(Quote, bid, ask)
+
+struct State
+{
+    int64_t seq = 0;
+    std::string symbol;
+    double price = 0.0;
+    std::vector<int> levels;
+    Quote quote;
+    std::optional<int> halt;
+};
+WWJSON_FIELDS(State, seq, symbol, price, levels, quote, halt)
+
+} // namespace delta_test
+
+using namespace delta_test;
+
+DEF_TAST(delta_update, "DeltaJson 只重新序列化脏字段")
+{
+    State state{1000, "ABC", 12.5, {1, 2}, {10, 11}, std::nullopt};
+    DeltaJson<State> delta;
+
+    DESC("首次构建与 to_json 一致");
+    COUT(delta.Build(state) == wwjson::to_json(state), true);
+    COUT(delta.changed(), 0x3Fu);
+    COUT(delta.dirty(), 0u);
+
+    DESC("等宽字段原位修补");
+    auto range = delta.range(0);
+    state.seq = 1001;
+    delta.MarkDirty(&State::seq);
+    COUT(delta.dirty(), 0x1u);
+    delta.Update(state);
+    COUT(delta.json() == wwjson::to_json(state), true);
+    COUT(delta.changed(), 0x1u);
+    COUT(delta.range(0) == range, true);
+    COUT(delta.MergePatch(), R"({"seq":1001})");
+
+    DESC("变宽字段重新拼接，后续字段偏移更新");
+    state.symbol = "ABCDEF";
+    state.quote.ask = 12;
+    state.halt = 3;
+    delta.MarkDirty(&State::symbol);
+    delta.MarkDirty(&State::quote);
+    delta.MarkDirty(5);
+    delta.Update(state);
+    COUT(delta.json(), wwjson::to_json(state));
+    COUT(delta.changed(), 0x32u);
+    COUT(delta.MergePatch(), R"({"symbol":"ABCDEF","quote":{"bid":10,"ask":12},"halt":3})");
+    range = delta.range(3);
+    COUT(delta.json().substr(range.first, range.second), "[1,2]");
+
+    DESC("标记但未变化的字段不计入变更");
+    delta.MarkDirty(&State::price);
+    delta.Update(state);
+    COUT(delta.changed(), 0u);
+    COUT(delta.MergePatch(), "{}");
+
+    DESC("未标记的字段不会重新序列化");
+    state.levels.push_back(3);
+    delta.Update(state);
+    COUT(delta.json() == wwjson::to_json(state), false);
+    delta.MarkAllDirty();
+    delta.Update(state);
+    COUT(delta.changed(), 0x8u);
+    COUT(delta.json() == wwjson::to_json(state), true);
+    COUT(test::IsJsonValid(delta.json()), true);
+}
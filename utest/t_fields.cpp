@@ -0,0 +1,267 @@
+/**
+ * @file t_fields.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for WWJSON_FIELDS descriptors from include/jfields.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jfields.hpp"
+#include <array>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace fields_test
+{
+
+struct Point
+{
+    int x = 0;
+    double y = 0.0;
+};
+WWJSON_FIELDS(Point, x, y)
+
+struct Shape
+{
+    std::string name;
+    bool closed = false;
+    std::vector<Point> points;
+    std::optional<int> color;
+    std::map<std::string, int> tags;
+    Point center;
+};
+WWJSON_FIELDS(Shape, name, closed, points, color, tags, center)
+
+/// Same members with hand-written to_json, as reference output.
+struct PointRef
+{
+    int x = 0;
+    double y = 0.0;
+    void to_json(Builder& builder) const
+    {
+        TO_JSON(x);
+        TO_JSON(y);
+    }
+};
+
+struct ShapeRef
+{
+    std::string name;
+    bool closed = false;
+    std::vector<PointRef> points;
+    std::optional<int> color;
+    std::map<std::string, int> tags;
+    PointRef center;
+    void to_json(Builder& builder) const
+    {
+        TO_JSON(name);
+        TO_JSON(closed);
+        TO_JSON(points);
+        TO_JSON(color);
+        TO_JSON(tags);
+        TO_JSON(center);
+    }
+};
+
+void MakeShape(Shape& shape, ShapeRef& ref, int n)
+{
+    shape.name = ref.name = "shape_" + std::to_string(n);
+    shape.closed = ref.closed = (n % 2 == 0);
+    for (int i = 0; i < n; ++i)
+    {
+        shape.points.push_back(Point{i, i * 0.5});
+        ref.points.push_back(PointRef{i, i * 0.5});
+    }
+    if (n % 3 != 0) { shape.color = ref.color = n * 10; }
+    for (int i = 0; i < n % 4; ++i)
+    {
+        shape.tags["t" + std::to_string(i)] = ref.tags["t" + std::to_string(i)] = i;
+    }
+    shape.center = Point{n, -n * 0.25};
+    ref.center = PointRef{n, -n * 0.25};
+}
+
+/// All members bounded, the maximum size is known at compile time.
+struct Sample
+{
+    int64_t id = 0;
+    bool active = false;
+    double score = 0.0;
+    char code[8] = {0};
+    std::optional<int16_t> level;
+    std::array<uint8_t, 3> rgb{};
+    Point origin;
+};
+WWJSON_FIELDS(Sample, id, active, score, code, level, rgb, origin)
+
+struct QuoteConfig : BasicConfig<std::string>
+{
+    static constexpr bool kQuoteNumber = true;
+};
+
+} // namespace fields_test
+
+using namespace fields_test;
+
+DEF_TAST(fields_table, "WWJSON_FIELDS 编译期生成的键片段")
+{
+    const auto& fields = wwjson_fields(static_cast<const Shape*>(nullptr));
+    COUT(fields.kCount, 6);
+    COUT(fields.fragment(0), "{\"name\":");
+    COUT(fields.fragment(1), ",\"closed\":");
+    COUT(fields.fragment(5), ",\"center\":");
+    COUT(fields.fragment(6), "},");
+    COUT(fields.name(0), "name");
+    COUT(fields.name(4), "tags");
+    COUT(detail::has_fields_v<Shape>, true);
+    COUT(detail::has_fields_v<ShapeRef>, false);
+    COUT(wwjson_fields(static_cast<const Point*>(nullptr)).text.size(), 12);
+}
+
+DEF_TAST(fields_to_json, "WWJSON_FIELDS 与手写 to_json 输出一致")
+{
+    DESC("简单结构体");
+    {
+        Point pt{3, 1.5};
+        COUT(wwjson::to_json(pt), R"({"x":3,"y":1.5})");
+    }
+
+    DESC("嵌套、数组、可选、映射各种成员");
+    for (int n : {0, 1, 2, 3, 5})
+    {
+        Shape shape;
+        ShapeRef ref;
+        MakeShape(shape, ref, n);
+        std::string json = wwjson::to_json(shape);
+        COUT(json == wwjson::to_json(ref), true);
+        COUT(test::IsJsonValid(json), true);
+    }
+
+    DESC("作为数组元素与带键成员");
+    {
+        std::vector<Shape> shapes(3);
+        std::vector<ShapeRef> refs(3);
+        for (int i = 0; i < 3; ++i) { MakeShape(shapes[i], refs[i], i + 1); }
+
+        Builder builder;
+        builder.BeginObject();
+        wwjson::to_json(builder, "shapes", shapes);
+        wwjson::to_json(builder, "first", shapes[0]);
+        builder.EndObject();
+
+        Builder expect;
+        expect.BeginObject();
+        wwjson::to_json(expect, "shapes", refs);
+        wwjson::to_json(expect, "first", refs[0]);
+        expect.EndObject();
+
+        std::string json = builder.MoveResult().str();
+        COUT(json == expect.MoveResult().str(), true);
+        COUT(test::IsJsonValid(json), true);
+    }
+
+    DESC("数字加引号的配置");
+    {
+        using QuoteBuilder = GenericBuilder<std::string, QuoteConfig>;
+        QuoteBuilder builder;
+        wwjson::to_json(builder, Point{7, 0.5});
+        COUT(builder.GetResult(), R"({"x":"7","y":"0.5"})");
+    }
+}
+
+DEF_TAST(fields_max_size, "max_json_size_v 编译期最大长度与 to_json_fast")
+{
+    DESC("标量与容器的最大长度");
+    static_assert(max_json_size_v<int32_t> == 11, "-2147483648");
+    static_assert(max_json_size_v<uint64_t> == 20, "18446744073709551615");
+    static_assert(max_json_size_v<bool> == 5, "false");
+    static_assert(max_json_size_v<char[8]> == 9, "quoted 7 chars");
+    static_assert(max_json_size_v<std::optional<int8_t>> == 4, "null or -128");
+    static_assert(max_json_size_v<std::array<int8_t, 3>> == 2 + 3 * 4 + 2, "[-128,-128,-128]");
+    static_assert(max_json_size_v<Point> == 12 - 1 + 11 + 24, "fragments and values");
+    static_assert(max_json_size_v<int, QuoteConfig> == 13, "quoted number");
+    COUT(max_json_size_v<Sample>);
+    COUT(is_json_bounded_v<Sample>, true);
+    COUT(is_json_bounded_v<Shape>, false);
+    COUT(is_json_bounded_v<std::string>, false);
+    COUT(is_json_bounded_v<std::optional<std::vector<int>>>, false);
+
+    DESC("极端值的输出不超过最大长度");
+    Sample sample;
+    sample.id = std::numeric_limits<int64_t>::min();
+    sample.active = false;
+    sample.score = -1234.5678;
+    ::memcpy(sample.code, "ABCDEFG", 8);
+    sample.level = std::numeric_limits<int16_t>::min();
+    sample.rgb = {255, 255, 255};
+    sample.origin = Point{std::numeric_limits<int>::min(), -1.7976931348623157e308};
+
+    std::string json = to_json_fast(sample);
+    COUT(json);
+    COUT(json == wwjson::to_json(sample), true);
+    COUT(json.size() <= max_json_size_v<Sample>, true);
+    COUT(test::IsJsonValid(json), true);
+
+    DESC("浮点数的最大长度覆盖两种格式的极端值");
+    {
+        auto length = [](auto value)
+        {
+            Builder builder;
+            wwjson::to_json(builder, std::array<decltype(value), 1>{value});
+            return builder.GetResult().size() - 2;
+        };
+        const float floats[] = {-8999999488000000.0f, -1000000054099968.0f, -16777215.5f,
+                                -std::numeric_limits<float>::max(), -std::numeric_limits<float>::min(),
+                                -std::numeric_limits<float>::denorm_min(), -1.17549435e-38f};
+        for (float value : floats) { COUT(length(value) <= max_json_size_v<float>, true); }
+        COUT(length(-8999999488000000.0f), 19);
+
+        const double doubles[] = {-281474976710656.0625, -4503599627370495.5,
+                                  -std::numeric_limits<double>::max(),
+                                  -std::numeric_limits<double>::denorm_min(), -1.7976931348623157e308};
+        for (double value : doubles) { COUT(length(value) <= max_json_size_v<double>, true); }
+        COUT(length(-281474976710656.0625), 21);
+
+        using Floats = std::array<float, 200>;
+        Floats many;
+        many.fill(-8999999488000000.0f);
+        std::string text = to_json_fast(many);
+        COUT(text.size() <= max_json_size_v<Floats>, true);
+        COUT(test::IsJsonValid(text), true);
+    }
+
+    DESC("无界类型回退到 Builder，其他结果类型");
+    {
+        Shape shape;
+        ShapeRef ref;
+        MakeShape(shape, ref, 4);
+        COUT(to_json_fast(shape) == wwjson::to_json(ref), true);
+
+        Point pt{1, 2.5};
+        JString js = to_json_fast<JString>(pt);
+        COUT(js.str(), R"({"x":1,"y":2.5})");
+        ReleasedBuffer rb = to_json_fast<ReleasedBuffer>(pt);
+        COUT(rb.view(), R"({"x":1,"y":2.5})");
+    }
+
+    DESC("末尾浮点数接近最大长度时不重新分配");
+    {
+        using Points = std::array<Point, 100>;
+        Points points;
+        points.fill(Point{std::numeric_limits<int>::min(), -1.7976931348623157e308});
+        ReleasedBuffer rb = to_json_fast<ReleasedBuffer>(points);
+        Builder expect;
+        wwjson::to_json(expect, points);
+        COUT(rb.view() == expect.MoveResult().str(), true);
+        // a reallocation would at least double the capacity
+        size_t once = max_json_size_v<Points> + 1 + detail::kNumberReserve + KString::kUnsafeLevel + 8;
+        COUT(max_json_size_v<Points> > 1024, true);
+        COUT(rb.capacity <= once, true);
+    }
+}
@@ -122,6 +122,35 @@ DEF_TAST(jbuilder_nested, "Builder 嵌套结构测试")
     COUT(test::IsJsonValid(result), true);
 }
 
+DEF_TAST(jbuilder_close_run, "Builder 连续大量闭括号不越过不安全余量")
+{
+    DESC("小容量 JString 构建器连续 2000 层开闭");
+    const int depth = 2000;
+    Builder builder(16);
+    for (int i = 0; i < depth; ++i) { builder.BeginArray(); }
+    for (int i = 0; i < depth; ++i) { builder.EndArray(); }
+    std::string result = builder.MoveResult().str();
+    COUT(result.size(), depth * 2);
+    COUT(result == std::string(depth, '[') + std::string(depth, ']'), true);
+
+    DESC("对象与数组交替闭合");
+    Builder mixed(16);
+    for (int i = 0; i < depth; ++i)
+    {
+        mixed.BeginObject();
+        mixed.PutKey("k");
+        mixed.BeginArray();
+    }
+    for (int i = 0; i < depth; ++i)
+    {
+        mixed.EndArray();
+        mixed.EndObject();
+    }
+    std::string text = mixed.MoveResult().str();
+    COUT(text.size(), depth * 8);
+    COUT(text.substr(text.size() - 4), "]}]}");
+}
+
 DEF_TAST(jbuilder_fast_basic, "FastBuilder 基本功能测试")
 {
     // 推荐用法：直接传容量参数
@@ -477,6 +506,21 @@ DEF_TAST(to_json_standalone, "standalone wwjson::to_json(struct)")
     }
 }
 
+DEF_TAST(to_json_result, "to_json_as 返回 JString 或 ReleasedBuffer 避免拷贝")
+{
+    test::Person p{"Alice", 35, {"789 Pine Rd", "Denver"}};
+    std::string expect = wwjson::to_json(p);
+    COUT(wwjson::to_json<test::Person>(p), expect);
+
+    JString js = wwjson::to_json_as<JString>(p);
+    COUT(js.str(), expect);
+
+    ReleasedBuffer rb = wwjson::to_json_as<ReleasedBuffer>(p);
+    COUT(rb.view(), expect);
+    COUT(std::strlen(rb.c_str()), expect.size());
+    COUT(test::IsJsonValid(rb.to_string()), true);
+}
+
 DEF_TAST(to_json_associative, "to_json associative containers (map)")
 {
     // Map to JSON object
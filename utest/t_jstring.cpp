@@ -611,6 +611,65 @@ DEF_TAST(jstr_extern_write, "StringBuffer 与外部方法写入集成协作")
     }
 }
 
+DEF_TAST(jstr_release, "JString 释放内存所有权零拷贝转交")
+{
+    DESC("release 转交原内存，自身变空");
+    {
+        JString buffer;
+        buffer.append("{\"key\":\"value\"}");
+        const char* origin = buffer.data();
+        size_t cap = buffer.capacity();
+
+        ReleasedBuffer rb = buffer.release();
+        COUT((void*)rb.ptr.get() == (void*)origin, true);
+        COUT(rb.size, 15);
+        COUT(rb.capacity, cap);
+        COUT(rb.view(), "{\"key\":\"value\"}");
+        COUT(rb.c_str()[rb.size] == '\0', true);
+        COUT(buffer.data() == nullptr, true);
+        COUT(buffer.empty(), true);
+
+        DESC("释放后仍可继续写入");
+        buffer.append("again");
+        COUT(buffer.str(), "again");
+
+        DESC("转成 std::string 只拷贝一次");
+        std::string str = rb.to_string();
+        COUT(str, "{\"key\":\"value\"}");
+        std::string prefix = "json=";
+        rb.append_to(prefix);
+        COUT(prefix, "json={\"key\":\"value\"}");
+
+        DESC("转交给 shared_ptr 不拷贝");
+        std::shared_ptr<char[]> shared = std::move(rb).share();
+        COUT((void*)shared.get() == (void*)origin, true);
+        COUT(static_cast<bool>(rb), false);
+        COUT(rb.view().empty(), true);
+    }
+
+    DESC("ReleasedBuffer 交还给 StringBuffer");
+    {
+        JString buffer;
+        buffer.append("abc");
+        const char* origin = buffer.data();
+        JString adopted(buffer.release());
+        COUT((void*)adopted.data() == (void*)origin, true);
+        COUT(adopted.str(), "abc");
+        adopted.append("def");
+        COUT(adopted.str(), "abcdef");
+    }
+
+    DESC("空内存的 release");
+    {
+        JString buffer;
+        JString moved(std::move(buffer));
+        ReleasedBuffer rb = buffer.release();
+        COUT(static_cast<bool>(rb), false);
+        COUT(rb.size, 0);
+        COUT(rb.data(), std::string(""));
+    }
+}
+
 /// @}
 /* ---------------------------------------------------------------------- */
 
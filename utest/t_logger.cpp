@@ -0,0 +1,167 @@
+/**
+ * @file t_logger.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for the NDJSON Logger from include/jlogger.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jlogger.hpp"
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wwjson;
+
+namespace
+{
+
+/// Options without timestamp, so that output can be compared exactly.
+LoggerOptions PlainOptions()
+{
+    LoggerOptions options;
+    options.timestamp = false;
+    options.interval = std::chrono::milliseconds(1000);
+    return options;
+}
+
+std::vector<std::string> SplitLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream is(text);
+    std::string line;
+    while (std::getline(is, line)) { lines.push_back(line); }
+    return lines;
+}
+
+} // namespace
+
+DEF_TAST(logger_line, "Logger 单行格式、级别过滤与 Flush")
+{
+    std::mutex mutex;
+    std::string output;
+    Logger logger([&](const char* data, size_t len) {
+        std::lock_guard<std::mutex> lock(mutex);
+        output.append(data, len);
+        return true;
+    }, PlainOptions());
+
+    COUT(logger.Info("login", [](Builder& b) {
+        b.AddMember("user", 42);
+        b.AddMember("ok", true);
+    }), true);
+    COUT(logger.Debug("hidden"), false);
+    COUT(logger.Warn("say \"hi\"\n"), true);
+    logger.SetLevel(LogLevel::Debug);
+    COUT(logger.Debug("shown"), true);
+
+    DESC("Flush 之前仍在线程缓冲中");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        COUT(output.empty(), true);
+    }
+    logger.Flush();
+    std::string expect =
+        "{\"level\":\"info\",\"msg\":\"login\",\"user\":42,\"ok\":true}\n"
+        "{\"level\":\"warn\",\"msg\":\"say \\\"hi\\\"\\n\"}\n"
+        "{\"level\":\"debug\",\"msg\":\"shown\"}\n";
+    COUT(output, expect);
+    COUT(logger.written(), expect.size());
+
+    DESC("error 级别立即交给写线程");
+    logger.Error("boom");
+    for (int i = 0; i < 100 && logger.written() == expect.size(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    COUT(logger.written() > expect.size(), true);
+}
+
+DEF_TAST(logger_threads, "Logger 多线程写文件，各线程内保持顺序")
+{
+    FILE* fp = std::tmpfile();
+    COUT(fp != nullptr, true);
+    if (fp == nullptr) { return; }
+
+    const int kThreads = 4;
+    const int kLines = 3000;
+    {
+        LoggerOptions options = PlainOptions();
+        options.buffer_size = 1024;
+        options.block = true;
+        options.max_pending = 8;
+        Logger logger(fileno(fp), options);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&logger, t] {
+                for (int i = 0; i < kLines; ++i)
+                {
+                    logger.Info("tick", [&](Builder& b) {
+                        b.AddMember("thread", t);
+                        b.AddMember("seq", i);
+                    });
+                }
+            });
+        }
+        for (auto& th : threads) { th.join(); }
+        COUT(logger.dropped(), 0);
+        COUT(logger.failed(), false);
+    }
+
+    std::string content;
+    std::rewind(fp);
+    char buf[4096];
+    size_t n = 0;
+    while ((n = std::fread(buf, 1, sizeof(buf), fp)) > 0) { content.append(buf, n); }
+    std::fclose(fp);
+
+    std::vector<std::string> lines = SplitLines(content);
+    COUT(lines.size(), kThreads * kLines);
+    COUT(test::IsJsonValid(lines.front()), true);
+
+    std::vector<int> next(kThreads, 0);
+    bool ordered = true;
+    for (auto& line : lines)
+    {
+        int t = 0;
+        int seq = 0;
+        if (std::sscanf(line.c_str(), "{\"level\":\"info\",\"msg\":\"tick\",\"thread\":%d,\"seq\":%d}",
+                        &t, &seq) != 2 || t < 0 || t >= kThreads || seq != next[t]++)
+        {
+            ordered = false;
+            break;
+        }
+    }
+    COUT(ordered, true);
+}
+
+DEF_TAST(logger_drop, "Logger 写线程阻塞时丢弃并计数")
+{
+    std::atomic<bool> release{false};
+    std::atomic<size_t> lines{0};
+    {
+        LoggerOptions options = PlainOptions();
+        options.buffer_size = 64;
+        options.max_pending = 1;
+        Logger logger([&](const char* data, size_t len) {
+            while (!release.load()) { std::this_thread::yield(); }
+            for (size_t i = 0; i < len; ++i) { lines += (data[i] == '\n'); }
+            return true;
+        }, options);
+
+        int accepted = 0;
+        for (int i = 0; i < 100; ++i)
+        {
+            accepted += logger.Info("msg", [i](Builder& b) { b.AddMember("i", i); });
+        }
+        COUT(logger.dropped() > 0, true);
+        COUT(accepted + logger.dropped(), 100);
+        release = true;
+        logger.Flush();
+        COUT(lines.load(), accepted);
+    }
+}
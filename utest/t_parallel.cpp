@@ -0,0 +1,284 @@
+/**
+ * @file t_parallel.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for ThreadPool and to_json_parallel from include/jparallel.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jparallel.hpp"
+#include "jsink.hpp"
+#include <atomic>
+#include <deque>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace
+{
+
+struct Record
+{
+    int id = 0;
+    std::string name;
+    double score = 0.0;
+    std::vector<int> tags;
+
+    void to_json(Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(name);
+        TO_JSON(score);
+        TO_JSON(tags);
+    }
+};
+
+struct EscapeConfig : UnsafeConfig<KString>
+{
+    static constexpr bool kEscapeValue = true;
+};
+
+std::vector<Record> MakeRecords(int count)
+{
+    std::vector<Record> records;
+    records.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        Record rec;
+        rec.id = i;
+        rec.name = "rec_" + std::to_string(i % 97);
+        rec.score = i * 0.5;
+        for (int k = 0; k < i % 4; ++k) { rec.tags.push_back(k); }
+        records.push_back(std::move(rec));
+    }
+    return records;
+}
+
+} // namespace
+
+DEF_TAST(parallel_pool, "ThreadPool 基本任务执行")
+{
+    DESC("多线程池执行全部任务");
+    {
+        ThreadPool pool(3);
+        COUT(pool.size(), 3);
+        std::atomic<int> sum{0};
+        std::vector<std::future<void>> futures;
+        for (int i = 1; i <= 100; ++i)
+        {
+            futures.push_back(pool.submit([&sum, i] { sum += i; }));
+        }
+        for (auto& f : futures) { f.get(); }
+        COUT(sum.load(), 5050);
+    }
+
+    DESC("0 线程池在调用线程内执行");
+    {
+        ThreadPool pool(0);
+        int value = 0;
+        auto f = pool.submit([&value] { value = 42; });
+        COUT(value, 42);
+        f.get();
+    }
+}
+
+DEF_TAST(parallel_array, "to_json_parallel 与串行输出逐字节一致")
+{
+    std::vector<Record> records = MakeRecords(5000);
+
+    Builder serial;
+    wwjson::to_json(serial, records);
+    std::string expect = serial.MoveResult().str();
+    COUT(test::IsJsonValid(expect), true);
+
+    for (size_t threads : {0, 1, 3, 7})
+    {
+        ThreadPool pool(threads);
+        Builder builder;
+        to_json_parallel(builder, records, pool);
+        std::string json = builder.MoveResult().str();
+        COUT(threads);
+        COUT(json == expect, true);
+    }
+
+    DESC("小块划分与顶层字符串结果");
+    {
+        ThreadPool pool(2);
+        std::string json = to_json_parallel(records, pool, 10);
+        COUT(json == expect, true);
+        JString js = to_json_parallel<JString>(records, pool);
+        COUT(js.str() == expect, true);
+    }
+}
+
+DEF_TAST(parallel_member, "to_json_parallel 作为对象成员及其他容器")
+{
+    ThreadPool pool(2);
+
+    DESC("带键名的成员数组");
+    {
+        std::vector<int> numbers;
+        for (int i = 0; i < 3000; ++i) { numbers.push_back(i * 7 - 1000); }
+
+        Builder serial;
+        serial.BeginObject();
+        serial.AddMember("head", "numbers");
+        wwjson::to_json(serial, "data", numbers);
+        serial.EndObject();
+
+        Builder builder;
+        builder.BeginObject();
+        builder.AddMember("head", "numbers");
+        to_json_parallel(builder, "data", numbers, pool);
+        builder.EndObject();
+
+        std::string json = builder.MoveResult().str();
+        COUT(json == serial.MoveResult().str(), true);
+        COUT(test::IsJsonValid(json), true);
+    }
+
+    DESC("std::deque 与空数组");
+    {
+        std::deque<double> values;
+        for (int i = 0; i < 2000; ++i) { values.push_back(i / 8.0); }
+        Builder serial;
+        wwjson::to_json(serial, values);
+        Builder builder;
+        to_json_parallel(builder, values, pool, 100);
+        COUT(builder.MoveResult().str() == serial.MoveResult().str(), true);
+
+        std::vector<int> empty;
+        COUT(to_json_parallel(empty, pool), "[]");
+    }
+}
+
+DEF_TAST(parallel_fixed_target, "to_json_parallel 写入不增长或流式输出的构建器")
+{
+    std::vector<std::string> texts;
+    for (int i = 0; i < 100000; ++i) { texts.push_back(std::string(49, 'a' + i % 26) + "\n"); }
+    Builder serial;
+    wwjson::to_json(serial, texts);
+    std::string expect = serial.MoveResult().str();
+
+    ThreadPool pool(3);
+    DESC("FastBuilder 目标只为总长度预留，分块写入可增长的构建器");
+    {
+        FastBuilder builder(expect.size() + 16);
+        to_json_parallel(builder, texts, pool);
+        COUT(builder.GetResult().str() == expect, true);
+    }
+
+    DESC("FlushBuilder 目标流式输出完整内容");
+    {
+        std::string out;
+        {
+            FlushBuilder builder(FlushString([&out](const char* data, size_t len) {
+                out.append(data, len);
+                return true;
+            }, 1024), 0);
+            to_json_parallel(builder, texts, pool);
+            COUT(builder.GetResult().finish(), true);
+        }
+        COUT(out.size(), expect.size());
+        COUT(out == expect, true);
+    }
+
+    DESC("分块沿用目标配置的选项");
+    {
+        using EscapeBuilder = GenericBuilder<KString, EscapeConfig>;
+        Builder escaped;
+        escaped.BeginArray();
+        for (const auto& text : texts) { escaped.AddItemEscape(text); }
+        escaped.EndArray();
+
+        EscapeBuilder builder(2 * expect.size());
+        to_json_parallel(builder, texts, pool);
+        COUT(builder.GetResult().str() == escaped.MoveResult().str(), true);
+    }
+}
+
+DEF_TAST(parallel_async_member, "AsyncObject 并行构建成员并按声明顺序拼接")
+{
+    std::vector<Record> records = MakeRecords(300);
+    std::map<std::string, int> counts;
+    for (int i = 0; i < 50; ++i) { counts["key_" + std::to_string(i)] = i * i; }
+
+    DESC("串行构建作为参照");
+    Builder serial;
+    serial.BeginObject();
+    serial.AddMember("id", 1);
+    wwjson::to_json(serial, "records", records);
+    serial.AddMember("name", "aggregate");
+    wwjson::to_json(serial, "counts", counts);
+    serial.AddMember("total", 300);
+    serial.EndObject();
+    std::string expect = serial.MoveResult().str();
+    COUT(test::IsJsonValid(expect), true);
+
+    for (size_t threads : {0, 2})
+    {
+        ThreadPool pool(threads);
+        Builder builder;
+        {
+            AsyncObject<Builder> obj(builder, pool);
+            obj.AddMember("id", 1);
+            obj.AddMemberAsync("records", [&](Builder& sub) { wwjson::to_json(sub, records); });
+            obj.AddMember("name", "aggregate");
+            obj.AddMemberAsync("counts", [&](Builder& sub) { wwjson::to_json(sub, counts); });
+            obj.AddMember("total", 300);
+        }
+        std::string json = builder.MoveResult().str();
+        COUT(threads);
+        COUT(json == expect, true);
+    }
+
+    DESC("FastBuilder 父对象，成员值远超其默认容量");
+    {
+        ThreadPool pool(2);
+        FastBuilder builder(256);
+        {
+            AsyncObject<FastBuilder> obj(builder, pool);
+            obj.AddMember("id", 1);
+            obj.AddMemberAsync("records", [&](auto& sub) { wwjson::to_json(sub, records); });
+            obj.AddMember("name", "aggregate");
+            obj.AddMemberAsync("counts", [&](auto& sub) { wwjson::to_json(sub, counts); });
+            obj.AddMember("total", 300);
+        }
+        COUT(expect.size() > 4096, true);
+        COUT(builder.GetResult().str() == expect, true);
+    }
+
+    DESC("数组中的对象，空值与异常转为 null");
+    {
+        ThreadPool pool(1);
+        Builder builder;
+        builder.BeginArray();
+        {
+            AsyncObject<Builder> obj(builder, pool);
+            obj.AddMemberAsync("empty", [](Builder&) {});
+            obj.AddMemberAsync("scalar", [](Builder& sub) { sub.AddItem(3.5); });
+        }
+        builder.AddItem("tail");
+        builder.EndArray();
+        COUT(builder.MoveResult().str(), R"([{"empty":null,"scalar":3.5},"tail"])");
+
+        Builder other;
+        bool thrown = false;
+        try
+        {
+            AsyncObject<Builder> obj(other, pool);
+            obj.AddMember("ok", true);
+            obj.AddMemberAsync("bad", [](Builder&) { throw std::runtime_error("fail"); });
+            obj.End();
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        COUT(thrown, true);
+        COUT(other.MoveResult().str(), R"({"ok":true,"bad":null})");
+    }
+}
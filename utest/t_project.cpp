@@ -0,0 +1,125 @@
+/**
+ * @file t_project.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for FieldProjection from include/jproject.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jproject.hpp"
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace project_test
+{
+
+struct Contact
+{
+    std::string email;
+    std::string phone;
+};
+WWJSON_FIELDS(Contact, email, phone)
+
+struct Member
+{
+    int id = 0;
+    std::string name;
+    Contact contact;
+    std::optional<Contact> backup;
+};
+WWJSON_FIELDS(Member, id, name, contact, backup)
+
+struct Team
+{
+    int id = 0;
+    std::string title;
+    std::vector<Member> members;
+    std::map<std::string, Contact> offices;
+    Member leader;
+    std::vector<int> scores;
+};
+WWJSON_FIELDS(Team, id, title, members, offices, leader, scores)
+
+Team MakeTeam()
+{
+    Team team;
+    team.id = 7;
+    team.title = "core";
+    team.members.push_back(Member{1, "Alice", {"a@x.org", "111"}, std::nullopt});
+    team.members.push_back(Member{2, "Bob", {"b@x.org", "222"}, Contact{"b2@x.org", "333"}});
+    team.offices["hq"] = Contact{"hq@x.org", "000"};
+    team.leader = team.members[0];
+    team.scores = {90, 85};
+    return team;
+}
+
+} // namespace project_test
+
+using namespace project_test;
+
+DEF_TAST(project_compile, "字段路径编译为逐层位掩码")
+{
+    DESC("顶层字段");
+    auto proj = FieldProjection::Compile<Team>("id, title,scores");
+    COUT(proj.mask(), 0x23u);
+    COUT(proj.Has(0), true);
+    COUT(proj.Has(2), false);
+    COUT(proj.Sub(0) == nullptr, true);
+
+    DESC("嵌套路径与未知字段");
+    proj = FieldProjection::Compile<Team>("members.name,members.contact.email,nothing,id.x,leader");
+    COUT(proj.mask(), 0x14u);
+    const FieldProjection* sub = proj.Sub(2);
+    COUT(sub != nullptr, true);
+    COUT(sub->mask(), 0x6u);
+    COUT(sub->Sub(2)->mask(), 0x1u);
+    COUT(proj.Sub(4) == nullptr, true);
+
+    DESC("整体选择覆盖部分选择");
+    proj = FieldProjection::Compile<Team>("leader.id,members.id,leader,leader.name");
+    COUT(proj.Sub(4) == nullptr, true);
+    COUT(proj.Sub(2)->mask(), 0x1u);
+
+    DESC("空路径不选择任何字段");
+    COUT(FieldProjection::Compile<Team>("").empty(), true);
+    COUT(FieldProjection::Compile<Team>(",,").empty(), true);
+}
+
+DEF_TAST(project_to_json, "按投影只序列化请求的字段")
+{
+    Team team = MakeTeam();
+
+    DESC("顶层字段");
+    auto proj = FieldProjection::Compile<Team>("scores,id");
+    std::string json = wwjson::to_json_projected(team, proj);
+    COUT(json, R"({"id":7,"scores":[90,85]})");
+
+    DESC("数组元素与可选成员的嵌套投影");
+    proj = FieldProjection::Compile<Team>("members.name,members.backup.phone,title");
+    json = wwjson::to_json_projected(team, proj);
+    COUT(json, R"({"title":"core","members":[{"name":"Alice","backup":null},{"name":"Bob","backup":{"phone":"333"}}]})");
+    COUT(test::IsJsonValid(json), true);
+
+    DESC("映射值与结构体成员的嵌套投影");
+    proj = FieldProjection::Compile<Team>("offices.email,leader.contact,leader.id");
+    json = wwjson::to_json_projected(team, proj);
+    COUT(json, R"({"offices":{"hq":{"email":"hq@x.org"}},"leader":{"id":1,"contact":{"email":"a@x.org","phone":"111"}}})");
+    COUT(test::IsJsonValid(json), true);
+
+    DESC("全部字段与完整序列化一致");
+    proj = FieldProjection::Compile<Team>("id,title,members,offices,leader,scores");
+    COUT(wwjson::to_json_projected(team, proj) == wwjson::to_json(team), true);
+
+    DESC("空投影与数组、带键成员");
+    COUT(wwjson::to_json_projected(team, FieldProjection()), "{}");
+    Builder builder;
+    builder.BeginObject();
+    wwjson::to_json_projected(builder, "team", team, FieldProjection::Compile<Team>("id"));
+    wwjson::to_json_projected(builder, "list", team.members, FieldProjection::Compile<Member>("id"));
+    builder.EndObject();
+    COUT(builder.GetResult(), R"({"team":{"id":7},"list":[{"id":1},{"id":2}]})");
+}
@@ -0,0 +1,131 @@
+/**
+ * @file t_pull.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for PullSerializer and to_json_chunks from include/jpull.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jpull.hpp"
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace
+{
+
+struct Item
+{
+    int id = 0;
+    std::string name;
+    std::vector<int> tags;
+
+    void to_json(Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(name);
+        TO_JSON(tags);
+    }
+};
+
+/// Serialize the whole value at once as reference.
+template <typename valueT>
+std::string SerialJson(const valueT& value)
+{
+    Builder builder;
+    wwjson::to_json(builder, value);
+    return builder.MoveResult().str();
+}
+
+/// Pull all chunks of `size` bytes, checking no chunk exceeds it.
+template <typename valueT>
+std::string PullJson(const valueT& value, size_t size, bool& bounded)
+{
+    PullSerializer puller(value);
+    std::vector<char> chunk(size);
+    std::string result;
+    bounded = true;
+    while (size_t n = puller.Read(chunk.data(), size))
+    {
+        if (n > size) { bounded = false; }
+        result.append(chunk.data(), n);
+    }
+    bounded = bounded && puller.done();
+    return result;
+}
+
+} // namespace
+
+DEF_TAST(pull_container, "PullSerializer 分块输出与一次性序列化一致")
+{
+    std::vector<Item> items;
+    for (int i = 0; i < 200; ++i)
+    {
+        items.push_back({i, "item_" + std::to_string(i), std::vector<int>(i % 4, i)});
+    }
+    std::string expect = SerialJson(items);
+    COUT(test::IsJsonValid(expect), true);
+
+    for (size_t size : {1, 7, 64, 4096})
+    {
+        bool bounded = false;
+        std::string json = PullJson(items, size, bounded);
+        COUT(size);
+        COUT(bounded, true);
+        COUT(json == expect, true);
+    }
+
+    DESC("嵌套容器、映射、可选值与空容器");
+    std::map<std::string, std::vector<std::vector<int>>> nested;
+    nested["a"] = {{1, 2}, {}, {3}};
+    nested["b"] = {};
+    nested["c"] = {{4}};
+    std::vector<std::optional<std::vector<int>>> optionals = {std::vector<int>{1}, std::nullopt};
+    std::vector<int> empty;
+
+    bool bounded = false;
+    COUT(PullJson(nested, 3, bounded), SerialJson(nested));
+    COUT(PullJson(nested, 3, bounded), R"({"a":[[1,2],[],[3]],"b":[],"c":[[4]]})");
+    COUT(PullJson(optionals, 2, bounded), R"([[1],null])");
+    COUT(PullJson(empty, 5, bounded), "[]");
+    COUT(PullJson(3.5, 1, bounded), "3.5");
+    COUT(PullJson(items[1], 4, bounded), SerialJson(items[1]));
+}
+
+DEF_TAST(pull_memory, "PullSerializer 内存随块大小而非总输出增长")
+{
+    std::vector<int> numbers(100000);
+    for (int i = 0; i < 100000; ++i) { numbers[i] = i * 13; }
+    std::string expect = SerialJson(numbers);
+
+    PullSerializer puller(numbers);
+    char chunk[512];
+    size_t total = 0;
+    size_t reads = 0;
+    bool same = true;
+    while (size_t n = puller.Read(chunk, sizeof(chunk)))
+    {
+        same = same && total + n <= expect.size() &&
+               ::memcmp(chunk, expect.data() + total, n) == 0;
+        total += n;
+        ++reads;
+    }
+    COUT(same, true);
+    COUT(total, expect.size());
+    COUT(reads, (expect.size() + sizeof(chunk) - 1) / sizeof(chunk));
+    COUT(puller.capacity() <= 2048, true);
+    COUT(puller.done(), true);
+
+#if WWJSON_HAS_COROUTINE
+    DESC("C++20 协程生成器");
+    std::string joined;
+    for (std::string_view piece : to_json_chunks(numbers, chunk, sizeof(chunk)))
+    {
+        joined.append(piece);
+    }
+    COUT(joined == expect, true);
+#endif
+}
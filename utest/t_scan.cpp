@@ -0,0 +1,95 @@
+/**
+ * @file t_scan.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for on-demand scanning from include/jscan.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jscan.hpp"
+#include "jbuilder.hpp"
+#include <string>
+
+using namespace wwjson;
+
+DEF_TAST(scan_path, "scan_path 按 JSON Pointer 取原始子树")
+{
+    std::string json = R"( {"code":0, "msg":"ok [not] {a} \"quoted\"",
+        "data": {"items": [1, {"id": 2, "tags": ["x", "y"]}, "three"],
+                 "a/b": true, "m~n": null, "": -1.5e3},
+        "tail": "\\"} )";
+
+    DESC("对象成员与数组元素");
+    COUT(scan_path(json, "/code"), "0");
+    COUT(scan_path(json, "/msg"), R"("ok [not] {a} \"quoted\"")");
+    COUT(scan_path(json, "/data/items"), R"([1, {"id": 2, "tags": ["x", "y"]}, "three"])");
+    COUT(scan_path(json, "/data/items/1/tags/1"), R"("y")");
+    COUT(scan_path(json, "/data/items/2"), R"("three")");
+    COUT(scan_path(json, "/tail"), R"("\\")");
+
+    DESC("空路径为整个文本，~1 ~0 转义与空键");
+    COUT(scan_path(json, "").front(), '{');
+    COUT(scan_path(json, "").back(), '}');
+    COUT(scan_path(json, "/data/a~1b"), "true");
+    COUT(scan_path(json, "/data/m~0n"), "null");
+    COUT(scan_path(json, "/data/"), "-1.5e3");
+
+    DESC("找不到返回空视图");
+    COUT(scan_path(json, "/none").empty(), true);
+    COUT(scan_path(json, "/data/items/3").empty(), true);
+    COUT(scan_path(json, "/data/items/x").empty(), true);
+    COUT(scan_path(json, "/code/0").empty(), true);
+    COUT(scan_path(json, "data").empty(), true);
+
+    DESC("截断与非法输入不越界");
+    COUT(scan_path(R"({"a":"abc)", "/a").empty(), true);
+    COUT(scan_path(R"({"a":[1,2)", "/a").empty(), true);
+    COUT(scan_path(R"({"a":[1,2)", "/a/1").empty(), true);
+    COUT(scan_path(R"({"a" 1})", "/a").empty(), true);
+    COUT(scan_path("", "/a").empty(), true);
+
+    DESC("单层查找");
+    COUT(scan_member(R"({"k":{"x":1}})", "k"), R"({"x":1})");
+    COUT(scan_item("[[],{},3]", 1), "{}");
+    COUT(scan_item("[]", 0).empty(), true);
+}
+
+DEF_TAST(scan_forward, "scan_path 子树经 AddMemberSub 转发")
+{
+    std::string longText(100, 'x');
+    Builder upstream;
+    upstream.BeginObject();
+    upstream.AddMember("skip", longText + "\\\"}]\\\\" + longText);  // escaped by hand
+    upstream.PutKey("data");
+    upstream.BeginObject();
+    upstream.PutKey("items");
+    upstream.BeginArray();
+    for (int i = 0; i < 10; ++i)
+    {
+        upstream.BeginObject();
+        upstream.AddMember("id", i);
+        upstream.AddMember("name", longText + std::to_string(i));
+        upstream.EndObject();
+    }
+    upstream.EndArray();
+    upstream.AddMember("total", 10);
+    upstream.EndObject();
+    upstream.EndObject();
+    std::string text = upstream.MoveResult().str();
+
+    std::string_view items = scan_path(text, "/data/items");
+    COUT(items.front(), '[');
+    COUT(items.back(), ']');
+    COUT(scan_path(text, "/data/items/9/id"), "9");
+    COUT(scan_path(text, "/data/total"), "10");
+
+    RawBuilder builder;
+    builder.BeginObject();
+    builder.AddMemberSub("items", items);
+    builder.AddMemberSub("total", scan_path(text, "/data/total"));
+    builder.EndObject();
+    std::string result = builder.GetResult();
+    COUT(test::IsJsonValid(result), true);
+    COUT(result.substr(0, 16), R"({"items":[{"id":)");
+    COUT(result.size(), items.size() + 21);
+}
@@ -0,0 +1,170 @@
+/**
+ * @file t_sink.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for FlushBuffer (streaming to sink) and FlushBuilder
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jsink.hpp"
+#include <cstdio>
+#include <string>
+
+using namespace wwjson;
+
+namespace
+{
+
+/// Build the same large array on any builder type.
+template <typename builderT>
+void BuildLargeArray(builderT& builder, int count)
+{
+    builder.BeginArray();
+    for (int i = 0; i < count; ++i)
+    {
+        builder.BeginObject();
+        builder.AddMember("id", i);
+        builder.AddMember("name", "item");
+        builder.AddMember("score", i + 0.5);
+        builder.AddMemberEscape("note", "tab\there");
+        builder.EndObject();
+    }
+    builder.EndArray();
+}
+
+/// Read whole content of a stdio stream from beginning.
+std::string ReadAll(FILE* fp)
+{
+    std::string content;
+    std::rewind(fp);
+    char buf[256];
+    size_t n = 0;
+    while ((n = std::fread(buf, 1, sizeof(buf), fp)) > 0)
+    {
+        content.append(buf, n);
+    }
+    return content;
+}
+
+} // namespace
+
+DEF_TAST(sink_flush_basic, "FlushBuffer 超过高水位时输出到回调")
+{
+    std::string out;
+    FlushString str([&out](const char* data, size_t len) {
+        out.append(data, len);
+        return true;
+    }, 32, 4);
+    size_t cap = str.capacity();
+    COUT(cap >= 32, true);
+
+    DESC("未达高水位不输出");
+    str.append("0123456789");
+    COUT(out.empty(), true);
+    COUT(str.size(), 10);
+
+    DESC("超过高水位，输出已完成部分，保留尾部");
+    str.append("abcdefghijklmnopqrstuvwxyz");
+    COUT(out.empty(), false);
+    COUT(str.flushed(), out.size());
+    COUT(str.total_size(), 36);
+    COUT(str.capacity(), cap);
+    COUT(str.size() >= 4, true);
+
+    DESC("flush 保留尾部，finish 输出全部");
+    str.flush();
+    COUT(str.size(), 4);
+    COUT(str.back(), 'z');
+    COUT(str.finish(), true);
+    COUT(str.empty(), true);
+    COUT(out, "0123456789abcdefghijklmnopqrstuvwxyz");
+
+    DESC("单次写入超过窗口时扩大窗口");
+    std::string big(100, 'x');
+    str.append(big);
+    COUT(str.capacity() >= 100, true);
+    str.finish();
+    COUT(out.size(), 136);
+}
+
+DEF_TAST(sink_builder, "FlushBuilder 流式构建大数组与内存构建一致")
+{
+    std::string out;
+    size_t peak = 0;
+    {
+        FlushBuilder builder(FlushString([&out](const char* data, size_t len) {
+            out.append(data, len);
+            return true;
+        }, 256), 0);
+
+        BuildLargeArray(builder, 1000);
+        peak = builder.json.capacity();
+        COUT(builder.json.flushed() > 0, true);
+        COUT(builder.GetResult().finish(), true);
+    }
+
+    Builder expect;
+    BuildLargeArray(expect, 1000);
+    std::string json = expect.MoveResult().str();
+
+    COUT(out.size(), json.size());
+    COUT(out == json, true);
+    COUT(test::IsJsonValid(out), true);
+    DESC("峰值窗口大小与文档长度无关");
+    COUT(peak < 512, true);
+    COUT(json.size() > 50000, true);
+}
+
+DEF_TAST(sink_file, "FlushBuilder 写入 FILE* 与文件描述符")
+{
+    Builder expect;
+    BuildLargeArray(expect, 200);
+    std::string json = expect.MoveResult().str();
+
+    DESC("FileSink");
+    {
+        FILE* fp = std::tmpfile();
+        COUT(fp != nullptr, true);
+        if (fp == nullptr) { return; }
+        {
+            FlushBuilder builder(FlushString(FileSink(fp), 1024), 0);
+            BuildLargeArray(builder, 200);
+            builder.GetResult();
+            // destructor flushes remaining bytes
+        }
+        std::fflush(fp);
+        COUT(ReadAll(fp) == json, true);
+        std::fclose(fp);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    DESC("FdSink");
+    {
+        FILE* fp = std::tmpfile();
+        COUT(fp != nullptr, true);
+        if (fp == nullptr) { return; }
+        {
+            FlushBuilder builder(FlushString(FdSink(fileno(fp)), 1024), 0);
+            BuildLargeArray(builder, 200);
+            COUT(builder.GetResult().finish(), true);
+        }
+        COUT(ReadAll(fp) == json, true);
+        std::fclose(fp);
+    }
+#endif
+}
+
+DEF_TAST(sink_fail, "FlushBuffer 输出失败后丢弃后续内容")
+{
+    int calls = 0;
+    FlushBuilder builder(FlushString([&calls](const char*, size_t) {
+        ++calls;
+        return false;
+    }, 64), 0);
+
+    BuildLargeArray(builder, 50);
+    COUT(builder.json.failed(), true);
+    COUT(calls, 1);
+    COUT(builder.json.capacity() < 128, true);
+    COUT(builder.GetResult().finish(), false);
+}
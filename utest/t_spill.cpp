@@ -0,0 +1,176 @@
+/**
+ * @file t_spill.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for SpillBuffer (caller buffer that spills to heap) and SpillBuilder
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jbuilder.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+
+using namespace wwjson;
+
+DEF_TAST(spill_construct, "SpillBuffer 借用外部内存构造")
+{
+    DESC("从 C 数组构造，内容写在栈上");
+    {
+        char buffer[64];
+        SpillString str(buffer);
+        COUT(str.capacity(), 63);
+        COUT(str.empty(), true);
+        COUT(str.spilled(), false);
+        COUT((void*)str.data() == (void*)buffer, true);
+
+        str.append("hello");
+        COUT(str.size(), 5);
+        COUT(str.spilled(), false);
+        COUT(std::string_view(buffer, 5), "hello");
+    }
+
+    DESC("从 std::array 与指针构造");
+    {
+        std::array<char, 32> arr;
+        SpillString str(arr);
+        COUT(str.capacity(), 31);
+        COUT((void*)str.data() == (void*)arr.data(), true);
+
+        char raw[16];
+        SpillString str2(raw, sizeof(raw));
+        COUT(str2.capacity(), 15);
+        COUT(str2.spilled(), false);
+    }
+
+    DESC("默认构造不借用内存，首次 reserve 申请堆内存");
+    {
+        SpillString str;
+        COUT(static_cast<bool>(str), false);
+        str.reserve(100);
+        COUT(str.spilled(), true);
+        COUT(str.capacity() >= 104, true);
+        str.append("abc");
+        COUT(str.str(), "abc");
+    }
+}
+
+DEF_TAST(spill_grow, "SpillBuffer 写满后转移至堆内存")
+{
+    char buffer[16];
+    SpillString str(buffer);
+
+    DESC("保留不安全边距：容量 15，写入 11 字节仍在栈上");
+    str.append("0123456789", 10);
+    str.push_back('a');
+    COUT(str.size(), 11);
+    COUT(str.spilled(), false);
+
+    DESC("再写入超出边距，拷贝前缀到堆内存");
+    str.append("bcdef");
+    COUT(str.spilled(), true);
+    COUT((void*)str.data() != (void*)buffer, true);
+    COUT(str.size(), 16);
+    COUT(str.str(), "0123456789abcdef");
+    COUT(str.capacity() >= 16 + SpillString::kUnsafeLevel, true);
+    COUT(*str.cap_end() == '\0', true);
+
+    DESC("转移后按 StringBuffer 策略继续扩容");
+    std::string expect = str.str();
+    for (int i = 0; i < 100; ++i)
+    {
+        str.append("xyz", 3);
+        expect.append("xyz", 3);
+    }
+    COUT(str.str() == expect, true);
+    COUT(str.spilled(), true);
+
+    DESC("resize 与 append 重复字符");
+    str.resize(4);
+    str.append(3, '!');
+    COUT(str.str(), "0123!!!");
+}
+
+DEF_TAST(spill_move, "SpillBuffer 移动语义")
+{
+    DESC("未转移时移动，仍指向借用的内存");
+    {
+        char buffer[32];
+        SpillString src(buffer);
+        src.append("stack");
+        SpillString dst(std::move(src));
+        COUT(dst.spilled(), false);
+        COUT((void*)dst.data() == (void*)buffer, true);
+        COUT(static_cast<bool>(src), false);
+        COUT(dst.str(), "stack");
+    }
+
+    DESC("已转移时移动，转交堆内存所有权");
+    {
+        char buffer[8];
+        SpillString src(buffer);
+        src.append("heap content");
+        COUT(src.spilled(), true);
+        const char* heap = src.data();
+
+        SpillString dst;
+        dst = std::move(src);
+        COUT(dst.spilled(), true);
+        COUT(src.spilled(), false);
+        COUT((void*)dst.data() == (void*)heap, true);
+        COUT(dst.str(), "heap content");
+    }
+}
+
+DEF_TAST(spill_builder, "SpillBuilder 栈内存构建 json")
+{
+    DESC("小 json 完全在栈上构建");
+    {
+        char buffer[128];
+        SpillBuilder builder(SpillString(buffer), 0);
+        builder.BeginObject();
+        builder.AddMember("name", "wwjson");
+        builder.AddMember("version", 1.1);
+        builder.AddMember("count", 12345);
+        builder.AddMemberEscape("text", "a\tb");
+        builder.EndObject();
+
+        std::string_view json = builder.GetResult();
+        COUT(json, R"({"name":"wwjson","version":1.1,"count":12345,"text":"a\tb"})");
+        COUT(builder.json.spilled(), false);
+        COUT((void*)json.data() == (void*)buffer, true);
+    }
+
+    DESC("大 json 转移至堆上，结果完整不截断");
+    {
+        char buffer[64];
+        SpillBuilder builder(SpillString(buffer), 0);
+        Builder expect;
+
+        builder.BeginArray();
+        expect.BeginArray();
+        for (int i = 0; i < 100; ++i)
+        {
+            builder.AddItem(i * 1001);
+            builder.AddItem("item");
+            builder.AddItem(i + 0.5);
+            expect.AddItem(i * 1001);
+            expect.AddItem("item");
+            expect.AddItem(i + 0.5);
+        }
+        builder.EndArray();
+        expect.EndArray();
+
+        std::string json = builder.GetResult().str();
+        COUT(builder.json.spilled(), true);
+        COUT(json == expect.GetResult().str(), true);
+        COUT(test::IsJsonValid(json), true);
+    }
+
+    DESC("默认容量参数会立即预留堆内存");
+    {
+        char buffer[64];
+        SpillBuilder builder{SpillString(buffer)};
+        COUT(builder.json.spilled(), true);
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file t_static.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for compile-time JSON from include/jstatic.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jstatic.hpp"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace wwjson;
+
+namespace static_test
+{
+
+struct Country
+{
+    const char* code;
+    const char* name;
+    int dial;
+    constexpr auto to_static_json() const
+    {
+        return static_object(static_member("code", code), static_member("name", name),
+                             static_member("dial", dial));
+    }
+};
+
+constexpr Country kCountries[] = {{"CN", "China", 86}, {"FR", "France", 33}, {"US", "United States", 1}};
+
+struct Defaults
+{
+    char mode[8] = "fast";
+    bool debug = false;
+    int64_t timeout = -1500;
+    std::array<uint16_t, 3> ports{80, 443, 8080};
+    constexpr auto to_static_json() const
+    {
+        return static_object(static_member("mode", mode), static_member("debug", debug),
+                             static_member("timeout", timeout), static_member("ports", ports),
+                             static_member("proxy", nullptr),
+                             static_member("note", std::string_view("a \"b\"\\c")));
+    }
+};
+
+constexpr Defaults kDefaults{};
+
+} // namespace static_test
+
+using namespace static_test;
+
+DEF_TAST(static_json, "编译期生成静态数据的 JSON")
+{
+    DESC("结构体数组");
+    constexpr auto countries = WWJSON_STATIC(kCountries);
+    static_assert(countries.size() == static_json_size(kCountries), "size computed");
+    static_assert(countries.view().substr(0, 12) == R"([{"code":"CN)", "written at compile time");
+    COUT(countries.view(),
+         R"([{"code":"CN","name":"China","dial":86},{"code":"FR","name":"France","dial":33},)"
+         R"({"code":"US","name":"United States","dial":1}])");
+    COUT(countries.c_str()[countries.size()] == '\0', true);
+
+    DESC("各种标量、数组、转义与 null");
+    constexpr auto defaults = WWJSON_STATIC(kDefaults);
+    COUT(defaults.view(),
+         R"({"mode":"fast","debug":false,"timeout":-1500,"ports":[80,443,8080],)"
+         R"("proxy":null,"note":"a \"b\"\\c"})");
+    COUT(test::IsJsonValid(defaults.str()), true);
+
+    DESC("整数极值与空数组");
+    constexpr std::array<int64_t, 2> limits{std::numeric_limits<int64_t>::min(),
+                                            std::numeric_limits<int64_t>::max()};
+    COUT(WWJSON_STATIC(limits).view(), "[-9223372036854775808,9223372036854775807]");
+    constexpr std::array<int, 0> empty{};
+    COUT(WWJSON_STATIC(empty).view(), "[]");
+    COUT(WWJSON_STATIC(static_object()).view(), "{}");
+
+    DESC("作为子串嵌入运行时构建");
+    RawBuilder builder;
+    builder.BeginObject();
+    builder.AddMember("version", 3);
+    builder.AddMemberSub("countries", countries.view());
+    builder.AddMemberSub("defaults", defaults);
+    builder.EndObject();
+    std::string json = builder.MoveResult();
+    COUT(json.size(), countries.size() + defaults.size() + 38);
+    COUT(test::IsJsonValid(json), true);
+}
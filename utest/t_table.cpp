@@ -0,0 +1,111 @@
+/**
+ * @file t_table.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for TableWriter from include/jtable.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jtable.hpp"
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace table_test
+{
+
+struct Row
+{
+    int64_t ts;
+    double val;
+    std::string tag;
+    void to_json(Builder& builder) const
+    {
+        TO_JSON(ts);
+        TO_JSON(val);
+        TO_JSON(tag);
+    }
+};
+
+} // namespace table_test
+
+using namespace table_test;
+
+DEF_TAST(table_columns, "TableWriter 列数据按行输出对象数组")
+{
+    std::vector<int64_t> ts{1700000000, 1700000001, 1700000002};
+    std::vector<double> val{0.5, -1.25, 3};
+    std::vector<std::string> tag{"cpu", "mem", "disk"};
+
+    DESC("与转置为结构体数组后的 to_json 一致");
+    auto table = make_table(column("ts", ts), column("val", val), column("tag", tag));
+    COUT(table.rows(), 3);
+    COUT(table.valid(), true);
+    COUT(table.fragment(0), "{\"ts\":");
+    COUT(table.fragment(2), ",\"tag\":");
+    std::string json = table.Render();
+
+    std::vector<Row> rows;
+    for (size_t i = 0; i < ts.size(); ++i) { rows.push_back(Row{ts[i], val[i], tag[i]}); }
+    Builder builder;
+    wwjson::to_json(builder, rows);
+    COUT(json, builder.MoveResult().str());
+    COUT(table.EstimateSize() >= json.size(), true);
+
+    DESC("各种列类型：bool、可选值、定长数组、嵌套容器");
+    std::vector<bool> ok{true, false};
+    std::vector<std::optional<int>> code{404, std::nullopt};
+    std::array<const char*, 2> name{"a", "b"};
+    std::vector<std::vector<int>> list{{1, 2}, {}};
+    auto mixed = make_table(column("ok", ok), column("code", code), column("list", list),
+                            column("name", name));
+    json = mixed.Render();
+    COUT(json, R"([{"ok":true,"code":404,"list":[1,2],"name":"a"},{"ok":false,"code":null,"list":[],"name":"b"}])");
+    COUT(test::IsJsonValid(json), true);
+
+    DESC("长度不等的列与空表");
+    std::vector<int> shorter{1};
+    auto uneven = make_table(column("ts", ts), column("n", shorter));
+    COUT(uneven.valid(), false);
+    COUT(uneven.Render(), R"([{"ts":1700000000,"n":1}])");
+    std::vector<int> none;
+    COUT(make_table(column("n", none)).Render(), "[]");
+
+    DESC("浮点列的估计长度覆盖最长的输出");
+    std::vector<float> wide(1000, -8999999488000000.0f);
+    auto floats = make_table(column("v", wide));
+    COUT(floats.EstimateSize() >= floats.Render().size(), true);
+
+    DESC("作为对象成员");
+    Builder outer;
+    outer.BeginObject();
+    table.Write(outer, "rows");
+    outer.AddMember("count", table.rows());
+    outer.EndObject();
+    COUT(test::IsJsonValid(outer.MoveResult().str()), true);
+}
+
+DEF_TAST(table_fast_builder, "TableWriter 写入 FastBuilder 时字符串长于采样平均")
+{
+    std::vector<int> id;
+    std::vector<std::string> tag;
+    std::vector<std::optional<std::string>> note;
+    for (int i = 0; i < 400; ++i)
+    {
+        id.push_back(i);
+        tag.push_back(i < 64 ? std::string(1, 'a') : std::string(300, 'b'));
+        note.push_back(i % 2 ? std::optional<std::string>(std::string(200, 'c')) : std::nullopt);
+    }
+    std::string long_name(400, 'n');
+    auto table = make_table(column("id", id), column("tag", tag), column(long_name, note));
+    std::string expect = table.Render();
+    COUT(table.EstimateSize() < expect.size(), true);
+
+    FastBuilder builder(16);
+    table.Write(builder);
+    COUT(builder.GetResult().str() == expect, true);
+    COUT(test::IsJsonValid(expect), true);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file t_template.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for JsonTemplate and WWJSON_TEMPLATE from include/jtemplate.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jtemplate.hpp"
+#include <optional>
+#include <string>
+
+using namespace wwjson;
+
+namespace
+{
+
+struct QuoteConfig : UnsafeConfig<JString>
+{
+    static constexpr bool kQuoteNumber = true;
+};
+
+} // namespace
+
+DEF_TAST(template_segment, "WWJSON_TEMPLATE 编译期切分字面片段")
+{
+    static constexpr auto tpl = WWJSON_TEMPLATE(R"({"code":{},"msg":{},"data":{"id":{}}})");
+    static_assert(tpl.kValues == 3, "three holes");
+    static_assert(tpl.literal_size() == 31, "literal bytes");
+
+    COUT(tpl.segment(0), R"({"code":)");
+    COUT(tpl.segment(1), R"(,"msg":)");
+    COUT(tpl.segment(2), R"(,"data":{"id":)");
+    COUT(tpl.segment(3), "}}");
+
+    DESC("无空位的模板与空对象写法");
+    static constexpr auto fixed = WWJSON_TEMPLATE(R"({"ok":true,"data":{ }})");
+    COUT(fixed.kValues, 0);
+    COUT(fixed.Render(), R"({"ok":true,"data":{ }})");
+}
+
+DEF_TAST(template_render, "JsonTemplate 渲染各类型值")
+{
+    static constexpr auto tpl = WWJSON_TEMPLATE(R"({"code":{},"msg":{},"data":{"id":{}}})");
+
+    DESC("与 Builder 逐个调用结果一致");
+    {
+        std::string json = tpl.Render(200, "OK", 12345);
+        COUT(json, R"({"code":200,"msg":"OK","data":{"id":12345}})");
+
+        Builder builder;
+        builder.BeginObject();
+        builder.AddMember("code", 200);
+        builder.AddMember("msg", "OK");
+        builder.BeginObject("data");
+        builder.AddMember("id", 12345);
+        builder.EndObject();
+        builder.EndObject();
+        COUT(json == builder.MoveResult().str(), true);
+        COUT(test::IsJsonValid(json), true);
+    }
+
+    DESC("浮点、布尔、空值、可选与字符串类型");
+    {
+        static constexpr auto mixed = WWJSON_TEMPLATE(R"([{},{},{},{},{},{},{}])");
+        std::string name = "wwjson";
+        std::optional<int> some = 7;
+        std::optional<int> none;
+        std::string json = mixed.Render(0.5, true, nullptr, some, none, name, std::string_view("sv"));
+        COUT(json, R"([0.5,true,null,7,null,"wwjson","sv"])");
+        COUT(test::IsJsonValid(json), true);
+    }
+
+    DESC("追加到已有构建器，数字加引号配置");
+    {
+        static constexpr auto item = WWJSON_TEMPLATE(R"({"id":{},"v":{}})");
+        GenericBuilder<JString, QuoteConfig> builder;
+        builder.BeginArray();
+        for (int i = 0; i < 3; ++i)
+        {
+            item.Write(builder, i, i * 10);
+            builder.SepItem();
+        }
+        builder.EndArray();
+        COUT(builder.MoveResult().str(),
+             R"([{"id":"0","v":"0"},{"id":"1","v":"10"},{"id":"2","v":"20"}])");
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file t_transcode.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for streaming rewrite from include/jtranscode.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jtranscode.hpp"
+#include <string>
+
+using namespace wwjson;
+
+DEF_TAST(transcode_copy, "transcode 无规则时原样复制令牌")
+{
+    TranscodeRules none;
+
+    DESC("去除空白，字符串与数字按原文复制");
+    std::string json = R"( { "a" : 1.50e+3 , "s" : "x\"é\\" ,
+        "arr" : [ true , null , [ ] , { } , -0 ] , "o" : { "k" : "v" } } )";
+    std::string out = transcode(json, none);
+    COUT(out, R"({"a":1.50e+3,"s":"x\"é\\","arr":[true,null,[],{},-0],"o":{"k":"v"}})");
+    COUT(test::IsJsonValid(out), true);
+
+    DESC("标量与空容器作根");
+    COUT(transcode("  42 ", none), "42");
+    COUT(transcode(R"("str")", none), R"("str")");
+    COUT(transcode("[]", none), "[]");
+
+    DESC("非法输入返回 false");
+    Builder builder;
+    COUT(transcode(builder, R"({"a":1)", none), false);
+    COUT(transcode(builder, R"({"a" 1})", none), false);
+    COUT(transcode(R"([1,2]])", none).empty(), true);
+    COUT(transcode(R"({"a":1,})", none).empty(), true);
+    COUT(transcode("", none).empty(), true);
+}
+
+DEF_TAST(transcode_rules, "transcode 删除、改名与数字引号规则")
+{
+    std::string json = R"({"code":0,"debug":{"trace":[1,{"x":"}"}]},
+        "data":{"items":[{"id":101,"ts":"1700000000","internal":1},
+                         {"id":102,"ts":"n/a","internal":{"deep":[]}}],
+                "ids":[7,8],"flag":true},
+        "internal":"top"})";
+
+    TranscodeRules rules;
+    rules.Drop("debug").Drop("*.internal")
+         .Rename("data.items.ts", "time")
+         .Quote("data.items.id").Quote("data.ids").Quote("data.flag")
+         .Unquote("data.items.ts");
+
+    std::string out = transcode(json, rules);
+    COUT(out, R"({"code":0,"data":{"items":[{"id":"101","time":1700000000},)"
+              R"({"id":"102","time":"n/a"}],"ids":["7","8"],"flag":"true"}})");
+    COUT(test::IsJsonValid(out), true);
+
+    DESC("Unquote 仅作用于数字文本");
+    TranscodeRules unquote;
+    unquote.Unquote("*.ts");
+    COUT(transcode(R"([{"ts":"-1.5e3"},{"ts":"12a"},{"ts":""}])", unquote),
+         R"([{"ts":-1.5e3},{"ts":"12a"},{"ts":""}])");
+    std::string loose = transcode(
+        R"([{"ts":"-"},{"ts":"1e"},{"ts":"1-2"},{"ts":"01"},{"ts":"1..2"},{"ts":"+1"},{"ts":".5"},{"ts":"0.5e-2"}])",
+        unquote);
+    COUT(loose, R"([{"ts":"-"},{"ts":"1e"},{"ts":"1-2"},{"ts":"01"},{"ts":"1..2"},{"ts":"+1"},{"ts":".5"},{"ts":0.5e-2}])");
+    COUT(test::IsJsonValid(loose), true);
+
+    DESC("删除首个、末个与全部成员");
+    TranscodeRules drop;
+    drop.Drop("a").Drop("c");
+    COUT(transcode(R"({"a":1,"b":2,"c":3})", drop), R"({"b":2})");
+    COUT(transcode(R"({"a":[1],"c":{}})", drop), "{}");
+    COUT(transcode(R"({"x":{"a":1}})", drop), R"({"x":{"a":1}})");
+
+    DESC("追加到已有构建器中");
+    Builder builder;
+    builder.BeginObject();
+    builder.PutKey("payload");
+    COUT(transcode(builder, R"({"a":1,"b":2})", drop), true);
+    builder.AddMember("ok", true);
+    builder.EndObject();
+    COUT(builder.GetResult(), R"({"payload":{"b":2},"ok":true})");
+
+    DESC("FastBuilder 输出因改名与加引号超过输入长度");
+    {
+        std::string input = "[";
+        std::string expect = "[";
+        for (int i = 0; i < 2000; ++i)
+        {
+            input += i > 0 ? R"(,{"id":1})" : R"({"id":1})";
+            expect += i > 0 ? R"(,{"identifier":"1"})" : R"({"identifier":"1"})";
+        }
+        input += "]";
+        expect += "]";
+        TranscodeRules grow;
+        grow.Quote("id").Rename("id", "identifier");
+        FastBuilder fast(16);
+        COUT(transcode(fast, input, grow), true);
+        COUT(fast.GetResult().str() == expect, true);
+        COUT(expect.size() > 2 * input.size(), true);
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * @file t_tree.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for iterative tree serialization from include/jtree.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "jtree.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace wwjson;
+
+namespace tree_test
+{
+
+struct Comment
+{
+    int id = 0;
+    std::string text;
+    std::vector<Comment> replies;
+
+    /// Recursive form, as reference output.
+    void to_json(Builder& builder) const
+    {
+        TO_JSON(id);
+        TO_JSON(text);
+        TO_JSON(replies);
+    }
+};
+
+struct Node
+{
+    int value = 0;
+    std::vector<std::unique_ptr<Node>> kids;
+};
+
+} // namespace tree_test
+
+template <>
+struct wwjson::TreeTraits<tree_test::Comment>
+{
+    static constexpr const char* kChildrenKey = "replies";
+    static const auto& Children(const tree_test::Comment& node) { return node.replies; }
+    template <typename builderT>
+    static void WriteFields(builderT& builder, const tree_test::Comment& node)
+    {
+        builder.AddMember("id", node.id);
+        builder.AddMember("text", node.text);
+    }
+};
+
+template <>
+struct wwjson::TreeTraits<tree_test::Node>
+{
+    static constexpr const char* kChildrenKey = "kids";
+    static const auto& Children(const tree_test::Node& node) { return node.kids; }
+    template <typename builderT>
+    static void WriteFields(builderT& builder, const tree_test::Node& node)
+    {
+        builder.AddMember("v", node.value);
+    }
+};
+
+using namespace tree_test;
+
+DEF_TAST(tree_iterative, "显式栈迭代序列化树结构")
+{
+    DESC("与递归 to_json 输出一致");
+    Comment root{1, "root", {}};
+    root.replies.push_back(Comment{2, "a", {}});
+    root.replies.push_back(Comment{3, "b", {Comment{4, "b1", {}}, Comment{5, "b2", {}}}});
+    root.replies[0].replies.push_back(Comment{6, "a1", {}});
+    std::string json = wwjson::to_json_tree(root);
+    COUT(json, wwjson::to_json(root));
+    COUT(test::IsJsonValid(json), true);
+
+    DESC("指针子节点与空指针");
+    Node tree;
+    tree.value = 10;
+    tree.kids.push_back(std::make_unique<Node>());
+    tree.kids.back()->value = 11;
+    tree.kids.push_back(nullptr);
+    COUT(wwjson::to_json_tree(tree), R"({"v":10,"kids":[{"v":11,"kids":[]},null]})");
+
+    DESC("作为数组元素写入已有构建器");
+    Builder builder;
+    builder.BeginArray();
+    wwjson::to_json_tree(builder, root.replies[1]);
+    wwjson::to_json_tree(builder, tree);
+    builder.EndArray();
+    COUT(test::IsJsonValid(builder.MoveResult().str()), true);
+}
+
+DEF_TAST(tree_deep, "深度 10^5 的链式树不溢出调用栈")
+{
+    const int depth = 100000;
+    Node root;
+    Node* tail = &root;
+    for (int i = 1; i < depth; ++i)
+    {
+        tail->kids.push_back(std::make_unique<Node>());
+        tail = tail->kids.back().get();
+        tail->value = i % 10;
+    }
+
+    std::string json = wwjson::to_json_tree(root);
+    std::string expect;
+    for (int i = 0; i < depth; ++i)
+    {
+        expect += "{\"v\":" + std::to_string(i % 10) + ",\"kids\":[";
+    }
+    for (int i = 0; i < depth; ++i) { expect += "]}"; }
+    COUT(json.size(), expect.size());
+    COUT(json == expect, true);
+
+    // release iteratively too, the unique_ptr chain would recurse
+    std::vector<std::unique_ptr<Node>> nodes;
+    for (auto next = std::move(root.kids); !next.empty();)
+    {
+        nodes.push_back(std::move(next.back()));
+        next = std::move(nodes.back()->kids);
+    }
+    while (!nodes.empty()) { nodes.pop_back(); }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file t_uring.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for AsyncWriter (io_uring or synchronous fallback) and BufferPool
+ */
+#include "couttast/tinytast.hpp"
+#include "test_util.h"
+#include "juring.hpp"
+#include <cstdio>
+#include <string>
+
+using namespace wwjson;
+
+namespace
+{
+
+/// Build one json line into builder.
+template <typename builderT>
+void BuildLine(builderT& builder, int id)
+{
+    builder.BeginObject();
+    builder.AddMember("id", id);
+    builder.AddMember("name", "line");
+    builder.AddMember("value", id * 0.25);
+    builder.EndObject();
+    builder.PutChar('\n');
+}
+
+/// Read whole content of a stdio stream from beginning.
+std::string ReadAll(FILE* fp)
+{
+    std::string content;
+    std::rewind(fp);
+    char buf[1024];
+    size_t n = 0;
+    while ((n = std::fread(buf, 1, sizeof(buf), fp)) > 0)
+    {
+        content.append(buf, n);
+    }
+    return content;
+}
+
+} // namespace
+
+DEF_TAST(uring_pool, "BufferPool 复用缓冲区")
+{
+    BufferPool pool(2);
+    JString a = pool.acquire(100);
+    COUT(a.capacity() >= 100, true);
+    a.append("abc");
+    const char* ptr = a.data();
+    pool.recycle(std::move(a));
+    COUT(pool.size(), 1);
+
+    JString b = pool.acquire(100);
+    COUT((void*)b.data() == (void*)ptr, true);
+    COUT(b.empty(), true);
+    COUT(pool.size(), 0);
+
+    DESC("池满时丢弃");
+    pool.recycle(JString(10));
+    pool.recycle(JString(10));
+    pool.recycle(JString(10));
+    COUT(pool.size(), 2);
+}
+
+DEF_TAST(uring_file, "AsyncWriter 异步写文件保持提交顺序")
+{
+    FILE* fp = std::tmpfile();
+    COUT(fp != nullptr, true);
+    if (fp == nullptr) { return; }
+
+    std::string expect;
+    {
+        AsyncWriter writer(fileno(fp), 8);
+        COUT(writer.async());
+        for (int i = 0; i < 1000; ++i)
+        {
+            Builder builder(writer.acquire(), 0);
+            BuildLine(builder, i);
+            expect.append(builder.GetResult().data(), builder.Size());
+            writer.submit(builder.MoveResult());
+        }
+        COUT(writer.drain(), true);
+        COUT(writer.inflight(), 0);
+        COUT(writer.written(), expect.size());
+        COUT(writer.pool().size() > 0, true);
+    }
+
+    std::string content = ReadAll(fp);
+    COUT(content.size(), expect.size());
+    COUT(content == expect, true);
+    std::fclose(fp);
+}
+
+DEF_TAST(uring_pipe, "AsyncWriter 写管道逐个在途保持顺序")
+{
+    int fds[2];
+    COUT(::pipe(fds), 0);
+
+    std::string expect;
+    {
+        AsyncWriter writer(fds[1], 4, 0);  // no batching: one write per buffer
+        for (int i = 0; i < 100; ++i)
+        {
+            Builder builder(writer.acquire(), 0);
+            BuildLine(builder, i);
+            expect.append(builder.GetResult().data(), builder.Size());
+            writer.submit(builder.MoveResult());
+        }
+        COUT(writer.drain(), true);
+    }
+    ::close(fds[1]);
+
+    std::string content;
+    char buf[1024];
+    ssize_t n = 0;
+    while ((n = ::read(fds[0], buf, sizeof(buf))) > 0)
+    {
+        content.append(buf, static_cast<size_t>(n));
+    }
+    ::close(fds[0]);
+    COUT(content == expect, true);
+}
+
+DEF_TAST(uring_sink, "AsyncWriter 作为 FlushBuilder 的输出端")
+{
+    FILE* fp = std::tmpfile();
+    COUT(fp != nullptr, true);
+    if (fp == nullptr) { return; }
+
+    Builder expect;
+    expect.BeginArray();
+    for (int i = 0; i < 500; ++i) { expect.AddItem(i); }
+    expect.EndArray();
+
+    {
+        AsyncWriter writer(fileno(fp));
+        FlushBuilder builder(FlushString(writer.sink(), 256), 0);
+        builder.BeginArray();
+        for (int i = 0; i < 500; ++i) { builder.AddItem(i); }
+        builder.EndArray();
+        COUT(builder.GetResult().finish(), true);
+        COUT(writer.drain(), true);
+    }
+
+    std::string content = ReadAll(fp);
+    COUT(content, expect.GetResult().str());
+    COUT(test::IsJsonValid(content), true);
+    std::fclose(fp);
+}
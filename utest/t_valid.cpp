@@ -0,0 +1,98 @@
+/**
+ * @file t_valid.cpp
+ * @author lymslive
+ * @date 2026-10-18
+ * @brief Tests for the JSON validator from include/jvalid.hpp
+ */
+#include "couttast/tinytast.hpp"
+#include "jbuilder.hpp"
+#include <string>
+
+using namespace wwjson;
+
+DEF_TAST(valid_grammar, "validate_json 语法检查与出错位置")
+{
+    DESC("合法文本");
+    COUT(is_json_valid(R"( {"a":[1,-0.5,2e10,-1E-3,true,false,null],"b":{},"c":[]} )"), true);
+    COUT(is_json_valid(R"("esc \" \\ \/ \b \f \n \r \t é \uD83D")"), true);
+    COUT(is_json_valid("\"中文 é 😀\""), true);
+    COUT(is_json_valid("0"), true);
+    COUT(is_json_valid(" \t\r\n[ ] "), true);
+    COUT(is_json_valid(std::string(100, '[') + std::string(100, ']')), true);
+
+    DESC("非法数字与字面量");
+    COUT(is_json_valid("01"), false);
+    COUT(is_json_valid("-"), false);
+    COUT(is_json_valid("1."), false);
+    COUT(is_json_valid(".5"), false);
+    COUT(is_json_valid("1e"), false);
+    COUT(is_json_valid("+1"), false);
+    COUT(is_json_valid("tru"), false);
+    COUT(is_json_valid("nulls"), false);
+
+    DESC("非法字符串");
+    COUT(is_json_valid(R"("abc)"), false);
+    COUT(is_json_valid(R"("\x")"), false);
+    COUT(is_json_valid(R"("\u12G4")"), false);
+    COUT(is_json_valid("\"tab\tinside\""), false);
+    COUT(is_json_valid("\"long string before a control \x01 byte\""), false);
+    COUT(is_json_valid("\"\xC0\xAF\""), false);          // overlong
+    COUT(is_json_valid("\"\xED\xA0\x80\""), false);      // surrogate
+    COUT(is_json_valid("\"\xE4\xB8\""), false);          // truncated
+    COUT(is_json_valid("\"\xF4\x90\x80\x80\""), false);  // above U+10FFFF
+
+    DESC("非法结构");
+    COUT(is_json_valid(""), false);
+    COUT(is_json_valid("[1,2"), false);
+    COUT(is_json_valid("[1,]"), false);
+    COUT(is_json_valid(R"({"a":1,})"), false);
+    COUT(is_json_valid(R"({"a" 1})"), false);
+    COUT(is_json_valid(R"({1:2})"), false);
+    COUT(is_json_valid("[1}"), false);
+    COUT(is_json_valid("[1] [2]"), false);
+    COUT(is_json_valid("1,"), false);
+
+    DESC("出错位置");
+    COUT(validate_json("[1,2]"), std::string_view::npos);
+    COUT(validate_json("[1,2,]"), 5);
+    COUT(validate_json(R"({"a":tru})"), 5);
+    COUT(validate_json("[1] x"), 4);
+
+    DESC("嵌套深度上限");
+    std::string deep = std::string(WWJSON_VALID_MAX_DEPTH, '[') + std::string(WWJSON_VALID_MAX_DEPTH, ']');
+    COUT(is_json_valid(deep), true);
+    COUT(is_json_valid("[" + deep + "]"), false);
+}
+
+struct CheckedConfig : UnsafeConfig<JString>
+{
+    static constexpr bool kValidateSub = true;
+};
+
+DEF_TAST(valid_builder, "kValidateSub 片段校验与 IsValid 输出检查")
+{
+    DESC("kValidateSub 将非法片段写为 null");
+    GenericBuilder<JString, CheckedConfig> checked;
+    checked.BeginObject();
+    checked.AddMemberSub("ok", R"({"x":[1,2]})");
+    checked.AddMemberSub("bad", R"({"x":[1,2})");
+    checked.EndObject();
+    COUT(checked.GetResult(), R"({"ok":{"x":[1,2]},"bad":null})");
+
+    DESC("默认配置按原样复制");
+    Builder plain;
+    plain.BeginArray();
+    plain.AddItemSub("[1,2");
+    plain.EndArray();
+    COUT(plain.IsValid(), false);
+
+    DESC("IsValid 忽略末尾逗号");
+    Builder builder;
+    builder.BeginObject();
+    builder.AddMember("a", 1);
+    builder.AddMember("s", "text");
+    COUT(builder.IsValid(), false);
+    builder.EndObject();
+    COUT(builder.json.back(), ',');
+    COUT(builder.IsValid(), true);
+}
@@ -1,13 +1,12 @@
 #include "test_util.h"
-#include "xyjson.h"
+#include "jvalid.hpp"
 
 namespace test
 {
 
 bool IsJsonValid(const std::string &json)
 {
-    yyjson::Document doc(json);
-    return doc.isValid();
+    return wwjson::is_json_valid(json);
 }
 
 } // namespace test